@@ -88,6 +88,14 @@ function verifyBuild() {
     log(`Generated files:`, 'success')
     log(`  - pentomino_solver.js (${(jsSize / 1024).toFixed(1)} KB)`, 'info')
     log(`  - pentomino_solver.wasm (${(wasmSize / 1024).toFixed(1)} KB)`, 'info')
+
+    const simdWasmFile = path.join(PUBLIC_WASM_DIR, 'pentomino_solver_simd.wasm')
+    if (fs.existsSync(simdWasmFile)) {
+      const simdSize = fs.statSync(simdWasmFile).size
+      log(`  - pentomino_solver_simd.wasm (${(simdSize / 1024).toFixed(1)} KB)`, 'info')
+    } else {
+      log('SIMD128 variant not found; browsers will use the baseline module', 'warning')
+    }
     return true
   } else {
     log('Expected output files not found!', 'error')
@@ -0,0 +1,379 @@
+#!/usr/bin/env node
+
+/**
+ * Streaming batch solver on the Node.js WebAssembly module (make node)
+ *
+ * Runs the same engine as the browser over JSON lines, one board per line,
+ * on a pool of worker_threads. Results stream to stdout as JSON lines in
+ * input order; boards are read only as fast as workers free up.
+ *
+ *   node scripts/solve-batch.js boards.jsonl > results.jsonl
+ *   cat boards.jsonl | node scripts/solve-batch.js --workers 8 --max-solutions 0
+ *   node scripts/solve-batch.js --bench --native build/native/pentomino_bench
+ *
+ * Input line: { "width": 10, "height": 6, "blocked": [[x, y], ...],
+ *   "pieces": [12 counts], "algorithm": "backtracking", "max_solutions": 1,
+ *   "max_time_ms": 30000, "max_nodes": 0, "deterministic": false, "id": anything }
+ *   - only width and height are required
+ * Output line: { "index", "id", "success", "solutions_found", "steps_explored",
+ *   "solving_time", "engine", "error"?, "timeout"?, "node_limit"?,
+ *   "board"? (with --board) }
+ */
+
+import fs from 'fs'
+import os from 'os'
+import path from 'path'
+import readline from 'readline'
+import { spawnSync } from 'child_process'
+import { performance } from 'perf_hooks'
+import { Worker, isMainThread, parentPort, workerData } from 'worker_threads'
+import { fileURLToPath, pathToFileURL } from 'url'
+
+const __filename = fileURLToPath(import.meta.url)
+const __dirname = path.dirname(__filename)
+
+const DEFAULT_MODULE = path.join(__dirname, '..', 'build', 'node', 'pentomino_solver.mjs')
+
+// Boards queued per worker before input reading pauses
+const IN_FLIGHT_PER_WORKER = 4
+
+// Standard boards of wasm/benchmark.cpp (same names, so native rows can be matched)
+const BENCH_BOARDS = [
+  { name: '6x10', width: 10, height: 6, blocked: [], max_solutions: 0 },
+  { name: '5x12', width: 12, height: 5, blocked: [], max_solutions: 0 },
+  { name: '4x15', width: 15, height: 4, blocked: [], max_solutions: 0 },
+  { name: '3x20', width: 20, height: 3, blocked: [], max_solutions: 0 },
+  { name: '8x8-center', width: 8, height: 8, blocked: [[3, 3], [4, 3], [3, 4], [4, 4]], max_solutions: 0 },
+  { name: '8x8-uncoverable', width: 8, height: 8, blocked: [[1, 0], [0, 1], [6, 7], [7, 7]], max_solutions: 0 },
+  { name: '5x24-double', width: 24, height: 5, blocked: [], max_solutions: 2000 },
+  { name: '5x36-triple', width: 36, height: 5, blocked: [], max_solutions: 1 },
+  { name: '10x24-quadruple', width: 24, height: 10, blocked: [], max_solutions: 1 },
+  { name: '6x50-quintuple', width: 50, height: 6, blocked: [], max_solutions: 1 },
+  { name: '10x30-quintuple', width: 30, height: 10, blocked: [], max_solutions: 1 }
+]
+
+function usage() {
+  console.error(`usage: solve-batch.js [options] [boards.jsonl ...]
+
+  --workers N          worker threads (default: available parallelism)
+  --module PATH        Node.js module from make node (default: build/node/pentomino_solver.mjs)
+  --max-solutions N    default per board, 0 = all (default 1)
+  --max-time MS        default per board, 0 = unlimited (default 30000)
+  --max-nodes N        default node budget per board, 0 = unlimited (default 0)
+  --deterministic      default per board: no clock checks, the time limit is ignored
+  --algorithm NAME     default per board (default backtracking)
+  --board              include the solved board in each result
+  --bench [BOARD ...]  run the standard boards on one worker instead of reading input
+  --native PATH        with --bench: also run pentomino_bench and compare
+  -r, --repeat N       with --bench: best of N runs (default 1)`)
+  process.exit(2)
+}
+
+function parseArgs(argv) {
+  const options = {
+    workers: os.availableParallelism ? os.availableParallelism() : os.cpus().length,
+    module: DEFAULT_MODULE,
+    maxSolutions: 1,
+    maxTime: 30000,
+    maxNodes: 0,
+    deterministic: false,
+    algorithm: 'backtracking',
+    board: false,
+    bench: false,
+    native: null,
+    repeat: 1,
+    inputs: []
+  }
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i]
+    const value = () => (i + 1 < argv.length ? argv[++i] : usage())
+    if (arg === '--workers') options.workers = Math.max(1, parseInt(value(), 10) || 1)
+    else if (arg === '--module') options.module = path.resolve(value())
+    else if (arg === '--max-solutions') options.maxSolutions = Math.max(0, parseInt(value(), 10) || 0)
+    else if (arg === '--max-time') options.maxTime = Math.max(0, parseInt(value(), 10) || 0)
+    else if (arg === '--max-nodes') options.maxNodes = Math.max(0, parseInt(value(), 10) || 0)
+    else if (arg === '--deterministic') options.deterministic = true
+    else if (arg === '--algorithm') options.algorithm = value()
+    else if (arg === '--board') options.board = true
+    else if (arg === '--bench') options.bench = true
+    else if (arg === '--native') options.native = path.resolve(value())
+    else if (arg === '-r' || arg === '--repeat') options.repeat = Math.max(1, parseInt(value(), 10) || 1)
+    else if (arg.startsWith('-')) usage()
+    else options.inputs.push(arg)
+  }
+  return options
+}
+
+// ---------------------------------------------------------------------------
+// Worker side: one module instance and one solver, reused for every board
+
+function blockedMask(width, height, blocked) {
+  const mask = new Uint8Array(Math.ceil((width * height) / 8))
+  for (const cell of blocked || []) {
+    const x = Array.isArray(cell) ? cell[0] : cell.x
+    const y = Array.isArray(cell) ? cell[1] : cell.y
+    if (x >= 0 && x < width && y >= 0 && y < height) {
+      const bit = y * width + x
+      mask[bit >> 3] |= 1 << (bit & 7)
+    }
+  }
+  return mask
+}
+
+function solveJob(wasm, solver, job) {
+  const board = job.board
+  solver.init_board_mask(board.width, board.height, blockedMask(board.width, board.height, board.blocked))
+  const counts = new wasm.VectorInt()
+  for (const count of board.pieces || []) counts.push_back(count)
+  solver.set_piece_counts(counts)
+  counts.delete()
+  const algorithm = board.algorithm ?? job.defaults.algorithm
+  if (!solver.set_algorithm(algorithm)) return { success: false, error: `Unknown algorithm: ${algorithm}` }
+  solver.set_config(board.max_solutions ?? job.defaults.maxSolutions, board.max_time_ms ?? job.defaults.maxTime,
+                    board.max_nodes ?? job.defaults.maxNodes)
+  solver.set_deterministic(board.deterministic ?? job.defaults.deterministic)
+
+  const start = performance.now()
+  const result = solver.solve()
+  result.wall_ms = performance.now() - start
+  if (job.withBoard && result.success && result.solutions_found > 0) result.board = solver.get_board()
+  return result
+}
+
+async function runWorker() {
+  const { modulePath, wasmModule } = workerData
+  const factory = (await import(pathToFileURL(modulePath).href)).default
+  // Instantiate the module the main thread compiled instead of compiling it again.
+  // The factory never settles when that fails, so the failure is raced against
+  // it and thrown from here, which ends the worker with an 'error' event
+  let fail
+  const failed = new Promise((_, reject) => { fail = reject })
+  const wasm = await Promise.race([
+    factory({
+      instantiateWasm(imports, receiveInstance) {
+        WebAssembly.instantiate(wasmModule, imports)
+          .then(instance => receiveInstance(instance, wasmModule))
+          .catch(fail)
+        return {}
+      }
+    }),
+    failed
+  ])
+  const solver = new wasm.PentominoSolver()
+  parentPort.on('message', job => {
+    let result
+    try {
+      result = solveJob(wasm, solver, job)
+    } catch (error) {
+      result = { success: false, error: error instanceof Error ? error.message : String(error) }
+    }
+    parentPort.postMessage({ index: job.index, result })
+  })
+  parentPort.postMessage({ ready: true })
+}
+
+// ---------------------------------------------------------------------------
+// Main thread: compile once, hand boards to idle workers, write in order
+
+class WorkerPool {
+  constructor(size, modulePath, wasmModule) {
+    this.idle = []
+    this.waiting = []   // jobs with no idle worker yet
+    this.pending = new Map()
+    this.workers = []
+    this.ready = Promise.all(Array.from({ length: size }, () => new Promise((resolve, reject) => {
+      const worker = new Worker(__filename, { workerData: { modulePath, wasmModule } })
+      worker.on('message', message => {
+        if (message.ready) {
+          resolve()
+        } else {
+          const settle = this.pending.get(message.index)
+          this.pending.delete(message.index)
+          settle(message.result)
+        }
+        this.release(worker)
+      })
+      // A worker only fails if the module does, so every other one would too
+      worker.on('error', error => {
+        reject(error)
+        console.error('❌ Worker failed:', error)
+        process.exit(1)
+      })
+      this.workers.push(worker)
+    })))
+  }
+
+  release(worker) {
+    const job = this.waiting.shift()
+    if (job) worker.postMessage(job)
+    else this.idle.push(worker)
+  }
+
+  run(job) {
+    return new Promise(resolve => {
+      this.pending.set(job.index, resolve)
+      const worker = this.idle.pop()
+      if (worker) worker.postMessage(job)
+      else this.waiting.push(job)
+    })
+  }
+
+  close() {
+    return Promise.all(this.workers.map(worker => worker.terminate()))
+  }
+}
+
+async function loadModule(modulePath) {
+  const wasmPath = modulePath.replace(/\.m?js$/, '.wasm')
+  if (!fs.existsSync(modulePath) || !fs.existsSync(wasmPath)) {
+    console.error(`❌ Node.js module not found: ${modulePath}`)
+    console.error('Build it with: cd wasm && make node')
+    process.exit(1)
+  }
+  return WebAssembly.compile(fs.readFileSync(wasmPath))
+}
+
+function write(stream, text) {
+  return stream.write(text) ? Promise.resolve() : new Promise(resolve => stream.once('drain', resolve))
+}
+
+function formatResult(index, board, result) {
+  const line = { index }
+  if (board && board.id !== undefined) line.id = board.id
+  for (const key of ['success', 'solutions_found', 'steps_explored', 'solving_time', 'engine', 'error', 'timeout', 'node_limit', 'board']) {
+    if (result[key] !== undefined) line[key] = result[key]
+  }
+  return JSON.stringify(line) + '\n'
+}
+
+async function solveStream(options, pool) {
+  const defaults = {
+    maxSolutions: options.maxSolutions,
+    maxTime: options.maxTime,
+    maxNodes: options.maxNodes,
+    deterministic: options.deterministic,
+    algorithm: options.algorithm
+  }
+  const limit = options.workers * IN_FLIGHT_PER_WORKER
+  const done = new Map()   // finished out of order, by index
+  let next = 0             // next index to write
+  let inFlight = 0
+  let freed = null         // resolves when a slot frees up
+  let writing = Promise.resolve()
+
+  const flush = () => {
+    while (done.has(next)) {
+      const text = done.get(next)
+      done.delete(next++)
+      writing = writing.then(() => write(process.stdout, text))
+    }
+  }
+
+  const submit = (index, line) => {
+    let board
+    try {
+      board = JSON.parse(line)
+      if (!Number.isInteger(board.width) || !Number.isInteger(board.height)) throw new Error('width and height are required')
+    } catch (error) {
+      done.set(index, formatResult(index, null, { success: false, error: `Invalid board: ${error.message}` }))
+      flush()
+      return
+    }
+    inFlight++
+    pool.run({ index, board, defaults, withBoard: options.board }).then(result => {
+      done.set(index, formatResult(index, board, result))
+      flush()
+      inFlight--
+      if (freed) freed()
+    })
+  }
+
+  const inputs = options.inputs.length > 0 ? options.inputs.map(file => fs.createReadStream(file)) : [process.stdin]
+  let index = 0
+  for (const input of inputs) {
+    for await (const line of readline.createInterface({ input, crlfDelay: Infinity })) {
+      if (!line.trim()) continue
+      while (inFlight >= limit) await new Promise(resolve => { freed = resolve })
+      freed = null
+      submit(index++, line)
+      await writing
+    }
+  }
+  while (inFlight > 0) await new Promise(resolve => { freed = resolve })
+  await writing
+  return index
+}
+
+// pentomino_bench row for one board: name algorithm solutions nodes ms ...
+function nativeRun(native, board, algorithm, repeat, maxNodes) {
+  const args = ['--board', board, '--algorithm', algorithm, '-r', String(repeat), '--max-nodes', String(maxNodes)]
+  const run = spawnSync(native, args, { encoding: 'utf8' })
+  const row = (run.stdout || '').split('\n').find(line => line.startsWith(board + ' '))
+  if (!row) return null
+  const columns = row.trim().split(/\s+/)
+  return { solutions: Number(columns[2]), nodes: Number(columns[3]), ms: Number(columns[4]) }
+}
+
+async function bench(options, pool) {
+  const selected = options.inputs.length > 0 ? BENCH_BOARDS.filter(b => options.inputs.includes(b.name)) : BENCH_BOARDS
+  const defaults = { maxSolutions: 0, maxTime: 0, maxNodes: options.maxNodes, deterministic: true, algorithm: options.algorithm }
+  const pad = (value, width) => String(value).padStart(width)
+
+  console.log(`algorithm: ${options.algorithm}, one worker${options.native ? `, native: ${options.native}` : ''}`)
+  console.log('')
+  console.log(`${'board'.padEnd(18)} ${pad('solutions', 10)} ${pad('nodes', 14)} ${pad('wasm ms', 10)} ${pad('Mnodes/s', 9)}` +
+              (options.native ? ` ${pad('native ms', 10)} ${pad('wasm/native', 12)}` : ''))
+  let index = 0
+  for (const board of selected) {
+    let best = null
+    for (let r = 0; r < options.repeat; r++) {
+      const result = await pool.run({ index: index++, board, defaults, withBoard: false })
+      if (!result.success) {
+        console.log(`${board.name.padEnd(18)} failed: ${result.error}`)
+        break
+      }
+      if (!best || result.wall_ms < best.wall_ms) best = result
+    }
+    if (!best) continue
+    let line = `${board.name.padEnd(18)} ${pad(best.solutions_found, 10)} ${pad(best.steps_explored, 14)} ` +
+               `${pad(best.wall_ms.toFixed(1), 10)} ${pad((best.steps_explored / best.wall_ms / 1000).toFixed(2), 9)}`
+    if (options.native) {
+      const native = nativeRun(options.native, board.name, options.algorithm, options.repeat, options.maxNodes)
+      if (!native) {
+        line += ` ${pad('n/a', 10)} ${pad('n/a', 12)}`
+      } else {
+        line += ` ${pad(native.ms.toFixed(1), 10)} ${pad((best.wall_ms / native.ms).toFixed(2) + 'x', 12)}`
+        if (native.nodes !== best.steps_explored) line += '  (node counts differ)'
+      }
+    }
+    console.log(line)
+  }
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2))
+  const wasmModule = await loadModule(options.module)
+  const pool = new WorkerPool(options.bench ? 1 : options.workers, options.module, wasmModule)
+  await pool.ready
+  try {
+    if (options.bench) {
+      await bench(options, pool)
+    } else {
+      const start = performance.now()
+      const boards = await solveStream(options, pool)
+      const ms = performance.now() - start
+      console.error(`${boards} boards in ${ms.toFixed(0)} ms on ${options.workers} workers`)
+    }
+  } finally {
+    await pool.close()
+  }
+}
+
+if (isMainThread) {
+  main().catch(error => {
+    console.error('❌ Batch solve failed:', error)
+    process.exit(1)
+  })
+} else {
+  runWorker()
+}
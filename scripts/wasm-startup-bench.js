@@ -0,0 +1,216 @@
+#!/usr/bin/env node
+
+/**
+ * Startup benchmark of the WebAssembly modules (make startup-bench)
+ *
+ * For every .wasm in a directory reports the bytes a browser downloads (raw,
+ * gzip -9 and the glue script), the compile time and the instantiate time.
+ * Each compile is measured in a fresh Node.js process, since V8 caches
+ * compiled modules within a process; the median of --runs is reported.
+ * Instantiation uses stub imports, so it measures the engine's work
+ * (memory, tables, start) without the Emscripten runtime.
+ *
+ *   node scripts/wasm-startup-bench.js --dir public/wasm
+ *   node scripts/wasm-startup-bench.js --json --budget-gzip-kb 64 --budget-compile-ms 50
+ *
+ * With a --budget-* option the exit status is 1 when any module exceeds it,
+ * so the benchmark can gate a CI job.
+ */
+
+import fs from 'fs'
+import path from 'path'
+import zlib from 'zlib'
+import { spawnSync } from 'child_process'
+import { performance } from 'perf_hooks'
+import { fileURLToPath } from 'url'
+
+const __filename = fileURLToPath(import.meta.url)
+const __dirname = path.dirname(__filename)
+
+const DEFAULT_DIR = path.join(__dirname, '..', 'public', 'wasm')
+
+function usage() {
+  console.error(`usage: wasm-startup-bench.js [options] [module.wasm ...]
+
+  --dir PATH              directory of .wasm files (default: public/wasm)
+  --runs N                compile/instantiate runs per module, median reported (default 5)
+  --json                  print one JSON object per module instead of a table
+  --budget-gzip-kb N      fail when a module's gzipped size exceeds N KiB
+  --budget-compile-ms N   fail when a module's median compile time exceeds N ms`)
+  process.exit(2)
+}
+
+function parseArgs(argv) {
+  const options = {
+    dir: DEFAULT_DIR,
+    runs: 5,
+    json: false,
+    budgetGzipKb: null,
+    budgetCompileMs: null,
+    measure: null,
+    files: []
+  }
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i]
+    const value = () => (i + 1 < argv.length ? argv[++i] : usage())
+    if (arg === '--dir') options.dir = path.resolve(value())
+    else if (arg === '--runs') options.runs = Math.max(1, parseInt(value(), 10) || 1)
+    else if (arg === '--json') options.json = true
+    else if (arg === '--budget-gzip-kb') options.budgetGzipKb = Math.max(0, parseFloat(value()) || 0)
+    else if (arg === '--budget-compile-ms') options.budgetCompileMs = Math.max(0, parseFloat(value()) || 0)
+    else if (arg === '--measure') options.measure = path.resolve(value())
+    else if (arg.startsWith('-')) usage()
+    else options.files.push(path.resolve(arg))
+  }
+  return options
+}
+
+// ---------------------------------------------------------------------------
+// Child side (--measure FILE): one cold compile and one instantiate
+
+// Imports satisfying the module's declarations; functions are no-ops
+function stubImports(module) {
+  const imports = {}
+  for (const { module: name, name: field, kind } of WebAssembly.Module.imports(module)) {
+    imports[name] ??= {}
+    if (kind === 'function') imports[name][field] = () => 0
+    else if (kind === 'memory') imports[name][field] = new WebAssembly.Memory({ initial: 256 })
+    else if (kind === 'table') imports[name][field] = new WebAssembly.Table({ initial: 4096, element: 'anyfunc' })
+    else if (kind === 'global') imports[name][field] = new WebAssembly.Global({ value: 'i32', mutable: true }, 0)
+  }
+  return imports
+}
+
+async function measure(file) {
+  const bytes = fs.readFileSync(file)
+  let start = performance.now()
+  const module = await WebAssembly.compile(bytes)
+  const compileMs = performance.now() - start
+
+  let instantiateMs = null
+  try {
+    start = performance.now()
+    await WebAssembly.instantiate(module, stubImports(module))
+    instantiateMs = performance.now() - start
+  } catch {
+    // Imports the stubs cannot satisfy (e.g. a table smaller than declared): compile time only
+  }
+  process.stdout.write(JSON.stringify({ compileMs, instantiateMs }))
+}
+
+// ---------------------------------------------------------------------------
+// Main side
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b)
+  const mid = sorted.length >> 1
+  return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2
+}
+
+// The Emscripten glue next to the .wasm, if any
+function glueBytes(file) {
+  const base = file.slice(0, -'.wasm'.length)
+  for (const ext of ['.js', '.mjs']) {
+    if (fs.existsSync(base + ext)) return fs.statSync(base + ext).size
+  }
+  return 0
+}
+
+function benchModule(file, runs) {
+  const bytes = fs.readFileSync(file)
+  const row = {
+    module: path.basename(file),
+    bytes: bytes.length,
+    gzipBytes: zlib.gzipSync(bytes, { level: 9 }).length,
+    glueBytes: glueBytes(file),
+    compileMs: null,
+    instantiateMs: null
+  }
+  if (!WebAssembly.validate(bytes)) {
+    row.error = 'not a valid WebAssembly module'
+    return row
+  }
+
+  const compiles = []
+  const instantiates = []
+  for (let run = 0; run < runs; run++) {
+    const child = spawnSync(process.execPath, [__filename, '--measure', file], { encoding: 'utf8' })
+    if (child.status !== 0) {
+      row.error = (child.stderr || `exit ${child.status}`).trim().split('\n').pop()
+      return row
+    }
+    const sample = JSON.parse(child.stdout)
+    compiles.push(sample.compileMs)
+    if (sample.instantiateMs !== null) instantiates.push(sample.instantiateMs)
+  }
+  row.compileMs = median(compiles)
+  if (instantiates.length > 0) row.instantiateMs = median(instantiates)
+  return row
+}
+
+function formatMs(ms) {
+  return ms === null ? '-' : ms.toFixed(2)
+}
+
+function printTable(rows) {
+  console.log(`${'module'.padEnd(32)} ${'bytes'.padStart(10)} ${'gzip'.padStart(10)} ${'glue'.padStart(8)} ` +
+              `${'compile ms'.padStart(11)} ${'inst ms'.padStart(9)}`)
+  for (const row of rows) {
+    console.log(`${row.module.padEnd(32)} ${String(row.bytes).padStart(10)} ${String(row.gzipBytes).padStart(10)} ` +
+                `${String(row.glueBytes).padStart(8)} ${formatMs(row.compileMs).padStart(11)} ` +
+                `${formatMs(row.instantiateMs).padStart(9)}${row.error ? `  (${row.error})` : ''}`)
+  }
+}
+
+function budgetFailures(rows, options) {
+  const failures = []
+  for (const row of rows) {
+    if (options.budgetGzipKb !== null && row.gzipBytes > options.budgetGzipKb * 1024) {
+      failures.push(`${row.module}: ${(row.gzipBytes / 1024).toFixed(1)} KiB gzipped exceeds ${options.budgetGzipKb} KiB`)
+    }
+    if (options.budgetCompileMs !== null && row.compileMs !== null && row.compileMs > options.budgetCompileMs) {
+      failures.push(`${row.module}: compile ${row.compileMs.toFixed(2)} ms exceeds ${options.budgetCompileMs} ms`)
+    }
+  }
+  return failures
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2))
+  if (options.measure) {
+    await measure(options.measure)
+    return
+  }
+
+  let files = options.files
+  if (files.length === 0) {
+    if (!fs.existsSync(options.dir)) {
+      console.error(`${options.dir}: no such directory (build the modules with make -C wasm all oz)`)
+      process.exit(1)
+    }
+    files = fs.readdirSync(options.dir)
+      .filter(name => name.endsWith('.wasm'))
+      .sort()
+      .map(name => path.join(options.dir, name))
+  }
+  if (files.length === 0) {
+    console.error(`No .wasm files in ${options.dir}`)
+    process.exit(1)
+  }
+
+  const rows = files.map(file => benchModule(file, options.runs))
+  if (options.json) {
+    for (const row of rows) console.log(JSON.stringify(row))
+  } else {
+    printTable(rows)
+  }
+
+  const failures = budgetFailures(rows, options)
+  for (const failure of failures) console.error(`over budget: ${failure}`)
+  if (failures.length > 0) process.exit(1)
+}
+
+main().catch(error => {
+  console.error(error)
+  process.exit(1)
+})
@@ -3,6 +3,14 @@ import type { Board, SolverAlgorithm, SolverEngine, SolverResult } from '../../t
 import { useSolver } from '../../hooks/useSolver'
 import './SolverPanel.css'
 
+const ALGORITHM_LABELS: Record<SolverAlgorithm, string> = {
+  'backtracking': 'Backtracking',
+  'dancing-links': 'Dancing Links',
+  'dancing-cells': 'Dancing Cells',
+  'bit-parallel': 'Bit-Parallel X',
+  'hybrid': 'Hybrid (DLX + Bitboard)',
+}
+
 interface SolverPanelProps {
   board: Board
   onSolutionApplied?: (solutionIndex: number) => void
@@ -87,7 +95,7 @@ export const SolverPanel: React.FC<SolverPanelProps> = ({
           >
             {availableAlgorithms.map(algorithm => (
               <option key={algorithm} value={algorithm}>
-                {algorithm === 'backtracking' ? 'Backtracking' : 'Dancing Links'}
+                {ALGORITHM_LABELS[algorithm]}
               </option>
             ))}
           </select>
@@ -136,10 +136,12 @@ export function useSolver({
     updateConfig({ algorithm })
   }, [updateConfig])
 
-  // Set engine
+  // Set engine; an algorithm the engine lacks falls back to Dancing Links
   const setEngine = useCallback((engine: SolverEngine) => {
-    updateConfig({ engine })
-  }, [updateConfig])
+    setConfig(prev => SolverFactory.getAvailableAlgorithms(engine).includes(prev.algorithm)
+      ? { ...prev, engine }
+      : { ...prev, engine, algorithm: 'dancing-links' })
+  }, [])
 
   // Set max time
   const setMaxTime = useCallback((maxTime: number) => {
@@ -167,7 +169,7 @@ export function useSolver({
   }, [])
 
   // Get available options
-  const availableAlgorithms = SolverFactory.getAvailableAlgorithms()
+  const availableAlgorithms = SolverFactory.getAvailableAlgorithms(config.engine)
   const availableEngines = SolverFactory.getAvailableEngines()
 
   // Get descriptions
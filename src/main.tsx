@@ -1,6 +1,7 @@
 import React from 'react'
 import ReactDOM from 'react-dom/client'
 import App from './App.tsx'
+import { isWasmSupported, preloadWasm } from './solvers/wasmLoader'
 import './styles/index.css'
 
 ReactDOM.createRoot(document.getElementById('root')!).render(
@@ -8,3 +9,11 @@ ReactDOM.createRoot(document.getElementById('root')!).render(
     <App />
   </React.StrictMode>,
 )
+
+// Compile the solver module while the page starts up, so the first
+// WebAssembly solve only instantiates it
+if (isWasmSupported()) {
+  preloadWasm().catch(() => {
+    // No build deployed: WebAssemblySolver falls back when it is used
+  })
+}
@@ -0,0 +1,213 @@
+/**
+ * Solver on the lean WebAssembly module (make lean): the C ABI of
+ * wasm/pentomino.h called directly, with buffers in linear memory instead
+ * of embind objects. Exposes the same methods as the embind PentominoSolver,
+ * plus start/step for time-sliced solving.
+ */
+
+// Exports of the lean module (LEAN_FUNCTIONS in wasm/Makefile); pointers are numbers
+export interface RawSolverModule {
+  HEAPU8: Uint8Array
+  UTF8ToString(pointer: number): string
+  stringToUTF8(text: string, pointer: number, maxBytes: number): void
+  lengthBytesUTF8(text: string): number
+  _malloc(size: number): number
+  _free(pointer: number): void
+  _pentomino_create(): number
+  _pentomino_destroy(solver: number): void
+  _pentomino_last_error(solver: number): number
+  _pentomino_set_board(solver: number, width: number, height: number, blocked: number): number
+  _pentomino_set_piece_counts(solver: number, counts: number): number
+  _pentomino_set_algorithm(solver: number, name: number): number
+  _pentomino_set_limits(solver: number, maxSolutions: number, maxTimeMs: number): number
+  _pentomino_set_node_limit(solver: number, maxNodes: bigint): number
+  _pentomino_set_deterministic(solver: number, enabled: number): number
+  _pentomino_set_solution_capacity(solver: number, capacity: number): number
+  _pentomino_solve(solver: number, result: number): number
+  _pentomino_start(solver: number): number
+  _pentomino_step(solver: number, nodeBudget: bigint): number
+  _pentomino_get_result(solver: number, result: number): number
+  _pentomino_stop(solver: number): void
+  _pentomino_get_progress(solver: number, progress: number): number
+  _pentomino_get_board(solver: number, cells: number): number
+}
+
+export interface RawSolveResult {
+  success: boolean
+  solutions_found: number
+  steps_explored: number
+  solving_time: number
+  engine?: string
+  timeout?: boolean
+  node_limit?: boolean
+  error?: string
+}
+
+const PIECE_TYPES = 12
+const PENTOMINO_OK = 0
+const PENTOMINO_TIMED_OUT = 1
+const PENTOMINO_NODE_LIMIT = 2
+
+// Scratch space for pentomino_result (40 bytes), pentomino_progress (24)
+// and the piece counts (12 int32), reused by every call
+const SCRATCH_BYTES = 64
+
+export function isRawSolverModule(module: unknown): module is RawSolverModule {
+  return typeof (module as Partial<RawSolverModule> | null)?._pentomino_create === 'function'
+}
+
+export class RawWasmSolver {
+  private module: RawSolverModule
+  private handle: number
+  private scratch: number
+  private cells = 0       // width * height int32 for get_board()
+  private width = 0
+  private height = 0
+
+  constructor(module: RawSolverModule) {
+    this.module = module
+    this.handle = module._pentomino_create()
+    if (this.handle === 0) throw new Error('Out of memory')
+    this.scratch = module._malloc(SCRATCH_BYTES)
+    // Only the first solution is read, from the board
+    module._pentomino_set_solution_capacity(this.handle, 0)
+  }
+
+  // Views must be taken after each call: memory growth replaces the buffer
+  private view(): DataView {
+    return new DataView(this.module.HEAPU8.buffer)
+  }
+
+  private lastError(): string {
+    return this.module.UTF8ToString(this.module._pentomino_last_error(this.handle))
+  }
+
+  // Throws when the module rejects the board; the previous one stays set
+  init_board(width: number, height: number, blockedCells: Array<{ x: number, y: number }>): void {
+    width = Math.max(width, 0)
+    height = Math.max(height, 0)
+    const bytes = Math.ceil((width * height) / 8)
+    const mask = this.module._malloc(Math.max(bytes, 1))
+    const heap = this.module.HEAPU8
+    heap.fill(0, mask, mask + bytes)
+    for (const cell of blockedCells) {
+      if (cell.x >= 0 && cell.x < width && cell.y >= 0 && cell.y < height) {
+        const bit = cell.y * width + cell.x
+        heap[mask + (bit >> 3)] |= 1 << (bit & 7)
+      }
+    }
+    const status = this.module._pentomino_set_board(this.handle, width, height, mask)
+    this.module._free(mask)
+    if (status !== PENTOMINO_OK) throw new Error(this.lastError())
+
+    this.width = width
+    this.height = height
+    if (this.cells !== 0) this.module._free(this.cells)
+    this.cells = this.module._malloc(Math.max(this.width * this.height, 1) * 4)
+  }
+
+  // maxNodes: budget for the whole search, 0 = unlimited
+  set_config(maxSolutions: number, maxTime: number, maxNodes = 0): void {
+    const status = this.module._pentomino_set_limits(this.handle, Math.max(maxSolutions, 0), Math.max(maxTime, 0))
+    if (status !== PENTOMINO_OK ||
+        this.module._pentomino_set_node_limit(this.handle, BigInt(Math.max(Math.floor(maxNodes), 0))) !== PENTOMINO_OK) {
+      throw new Error(this.lastError())
+    }
+  }
+
+  // No wall-clock checks: the time limit is ignored, runs are reproducible
+  set_deterministic(enabled: boolean): void {
+    this.module._pentomino_set_deterministic(this.handle, enabled ? 1 : 0)
+  }
+
+  // Missing entries count as 0; empty restores whole sets
+  set_piece_counts(counts: number[]): void {
+    if (counts.length === 0) {
+      this.module._pentomino_set_piece_counts(this.handle, 0)
+      return
+    }
+    const view = this.view()
+    for (let p = 0; p < PIECE_TYPES; p++) view.setInt32(this.scratch + 4 * p, counts[p] ?? 0, true)
+    this.module._pentomino_set_piece_counts(this.handle, this.scratch)
+  }
+
+  set_algorithm(algorithm: string): boolean {
+    const size = this.module.lengthBytesUTF8(algorithm) + 1
+    const name = this.module._malloc(size)
+    this.module.stringToUTF8(algorithm, name, size)
+    const status = this.module._pentomino_set_algorithm(this.handle, name)
+    this.module._free(name)
+    return status === PENTOMINO_OK
+  }
+
+  solve(): RawSolveResult {
+    const status = this.module._pentomino_solve(this.handle, this.scratch)
+    return this.readResult(status)
+  }
+
+  // Time-sliced solving: start(), then step() until it returns true
+  start(): boolean {
+    return this.module._pentomino_start(this.handle) === PENTOMINO_OK
+  }
+
+  step(nodeBudget: number): boolean {
+    return this.module._pentomino_step(this.handle, BigInt(Math.max(Math.floor(nodeBudget), 0))) !== 0
+  }
+
+  result(): RawSolveResult {
+    return this.readResult(this.module._pentomino_get_result(this.handle, this.scratch))
+  }
+
+  get_board(): number[][] {
+    if (this.cells === 0 || this.module._pentomino_get_board(this.handle, this.cells) !== PENTOMINO_OK) return []
+    const view = this.view()
+    const rows: number[][] = []
+    for (let y = 0; y < this.height; y++) {
+      const row: number[] = []
+      for (let x = 0; x < this.width; x++) row.push(view.getInt32(this.cells + 4 * (y * this.width + x), true))
+      rows.push(row)
+    }
+    return rows
+  }
+
+  stop(): void {
+    this.module._pentomino_stop(this.handle)
+  }
+
+  get_progress(): { steps_explored: number, solutions_found: number, time_elapsed: number } {
+    this.module._pentomino_get_progress(this.handle, this.scratch)
+    const view = this.view()
+    return {
+      steps_explored: Number(view.getBigInt64(this.scratch, true)),
+      solutions_found: Number(view.getBigInt64(this.scratch + 8, true)),
+      time_elapsed: Number(view.getBigInt64(this.scratch + 16, true)),
+    }
+  }
+
+  // Frees the solver and its buffers; the object is unusable afterwards
+  delete(): void {
+    if (this.handle === 0) return
+    this.module._pentomino_destroy(this.handle)
+    this.module._free(this.scratch)
+    if (this.cells !== 0) this.module._free(this.cells)
+    this.handle = 0
+    this.cells = 0
+  }
+
+  // pentomino_result at scratch: success 0, timed_out 4, solutions 8, nodes 16, solving_ms 24, engine 32
+  private readResult(status: number): RawSolveResult {
+    const view = this.view()
+    const result: RawSolveResult = {
+      success: status === PENTOMINO_OK && view.getInt32(this.scratch, true) !== 0,
+      solutions_found: Number(view.getBigInt64(this.scratch + 8, true)),
+      steps_explored: Number(view.getBigInt64(this.scratch + 16, true)),
+      solving_time: Number(view.getBigInt64(this.scratch + 24, true)),
+      engine: this.module.UTF8ToString(view.getUint32(this.scratch + 32, true)),
+    }
+    if (!result.success) result.error = this.lastError()
+    const stoppedBy = view.getInt32(this.scratch + 4, true)
+    if (stoppedBy === PENTOMINO_TIMED_OUT) result.timeout = true
+    else if (stoppedBy === PENTOMINO_NODE_LIMIT) result.node_limit = true
+    return result
+  }
+}
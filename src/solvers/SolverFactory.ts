@@ -35,6 +35,9 @@ export class SolverFactory {
       switch (config.algorithm) {
         case 'backtracking':
         case 'dancing-links':
+        case 'dancing-cells':
+        case 'bit-parallel':
+        case 'hybrid':
           return new WebAssemblySolver(config)
         default:
           throw new Error(`WebAssembly implementation not available for algorithm: ${config.algorithm}`)
@@ -49,16 +52,28 @@ export class SolverFactory {
       case 'dancing-links':
         return new DancingLinksSolver(config)
 
+      case 'dancing-cells':
+        throw new Error('Dancing Cells is only available with the WebAssembly engine')
+
+      case 'bit-parallel':
+        throw new Error('Bit-parallel Algorithm X is only available with the WebAssembly engine')
+
+      case 'hybrid':
+        throw new Error('The hybrid solver is only available with the WebAssembly engine')
+
       default:
         throw new Error(`Unknown algorithm: ${config.algorithm}`)
     }
   }
 
   /**
-   * Get available algorithms
+   * Get available algorithms, optionally only those the given engine implements
    */
-  static getAvailableAlgorithms(): SolverAlgorithm[] {
-    return ['backtracking', 'dancing-links']
+  static getAvailableAlgorithms(engine?: SolverEngine): SolverAlgorithm[] {
+    if (engine === 'javascript') {
+      return ['backtracking', 'dancing-links']
+    }
+    return ['backtracking', 'dancing-links', 'dancing-cells', 'bit-parallel', 'hybrid']
   }
 
   /**
@@ -94,7 +109,7 @@ export class SolverFactory {
   static validateConfig(config: SolverConfig): string[] {
     const errors: string[] = []
 
-    if (!this.getAvailableAlgorithms().includes(config.algorithm)) {
+    if (!this.getAvailableAlgorithms(config.engine).includes(config.algorithm)) {
       errors.push(`Invalid algorithm: ${config.algorithm}`)
     }
 
@@ -123,6 +138,15 @@ export class SolverFactory {
       
       case 'dancing-links':
         return 'Knuth\'s Algorithm X with Dancing Links. Highly optimized for exact cover problems. Faster than backtracking but less intuitive for visualization.'
+
+      case 'dancing-cells':
+        return 'Algorithm X with Knuth\'s Dancing Cells: sparse sets instead of linked lists, undone by restoring set lengths. WebAssembly engine only.'
+
+      case 'bit-parallel':
+        return 'Algorithm X on row bitsets: covering is a SIMD AND-NOT, column choice a vector popcount, and backtracking pops a stack frame. WebAssembly engine only.'
+
+      case 'hybrid':
+        return 'Dancing Links for the first few levels, then the bitboard search on the remaining board. The split depth is tuned per board shape. WebAssembly engine only.'
       
       default:
         return 'Unknown algorithm'
@@ -5,18 +5,24 @@ import type {
   SolverSolution,
   PentominoType
 } from '../types'
+import { RawWasmSolver, isRawSolverModule } from './RawWasmSolver'
+import { getStartupStats, isSimdSupported, isWasmSupported, loadSolverModule } from './wasmLoader'
 
-// WebAssembly module interface
+// Solver of either module: embind PentominoSolver or RawWasmSolver over the lean one
 interface PentominoSolverWasm {
-  new(): any
   init_board(width: number, height: number, blocked_cells: Array<{x: number, y: number}>): void
-  set_config(max_solutions: number, max_time: number): void
+  set_config(max_solutions: number, max_time: number, max_nodes?: number): void
+  set_deterministic?(enabled: boolean): void
+  set_piece_counts?(counts: number[]): void
+  set_algorithm?(algorithm: string): boolean
   solve(): {
     success: boolean
     solutions_found: number
     steps_explored: number
     solving_time: number
+    engine?: string
     timeout?: boolean
+    node_limit?: boolean
     error?: string
   }
   get_board(): number[][]
@@ -28,6 +34,36 @@ interface PentominoSolverWasm {
   }
 }
 
+// One native solver per loaded module, shared by every WebAssemblySolver:
+// native solvers live on the module's heap and are never freed by the GC
+const nativeSolvers = new WeakMap<object, PentominoSolverWasm>()
+
+// Module loaded by the fallback path, likewise kept for the page
+let fallbackModule: Promise<any> | null = null
+
+async function loadFallbackModule(): Promise<any> {
+  let wasmModuleFactory: any
+  try {
+    const baselinePath = '/wasm/pentomino_solver.js'
+    wasmModuleFactory = await import(/* @vite-ignore */ baselinePath)
+  } catch {
+    const fallbackPath = '/wasm/fallback.js'
+    wasmModuleFactory = await import(/* @vite-ignore */ fallbackPath)
+  }
+  return wasmModuleFactory.default()
+}
+
+function nativeSolver(wasmModule: any): PentominoSolverWasm {
+  const cached = nativeSolvers.get(wasmModule)
+  if (cached) return cached
+  // The lean module only has the raw C exports
+  const solver: PentominoSolverWasm = isRawSolverModule(wasmModule)
+    ? new RawWasmSolver(wasmModule)
+    : new wasmModule.PentominoSolver()
+  nativeSolvers.set(wasmModule, solver)
+  return solver
+}
+
 /**
  * Real WebAssembly-based pentomino solver
  * Uses compiled C++ for maximum performance
@@ -46,31 +82,30 @@ export class WebAssemblySolver {
 
   /**
    * Initialize WebAssembly module
-   * Loads the compiled C++ pentomino solver
+   * Uses the native solver of the page's shared module (wasmLoader),
+   * which main.tsx starts compiling at page load
    */
   private async initializeWasm(): Promise<boolean> {
+    if (this.wasmSolver) return true
     try {
-      console.log('WebAssembly solver: Loading WASM module...')
-
-      // Try to load the WebAssembly module
-      let wasmModuleFactory: any
       try {
-        // Use dynamic import with string template to avoid TypeScript module resolution
-        const modulePath = '/wasm/pentomino_solver.js'
-        wasmModuleFactory = await import(/* @vite-ignore */ modulePath)
-        console.log('WebAssembly-compatible module loaded successfully!')
-      } catch (wasmError) {
-        console.warn('WASM module not found, trying fallback...')
-        // Try fallback module
-        const fallbackPath = '/wasm/fallback.js'
-        wasmModuleFactory = await import(/* @vite-ignore */ fallbackPath)
+        this.wasmModule = await loadSolverModule()
+        const stats = getStartupStats()
+        if (stats) {
+          console.log(`WebAssembly solver: ${stats.build} compiled in ${stats.compileMs.toFixed(1)} ms, ` +
+                      `instantiated in ${stats.instantiateMs.toFixed(1)} ms`)
+        }
+      } catch {
+        // No compiled build: let a module load itself, else use the JS fallback
+        console.warn('WASM build not available, trying fallback...')
+        if (!fallbackModule) {
+          fallbackModule = loadFallbackModule()
+          fallbackModule.catch(() => { fallbackModule = null })
+        }
+        this.wasmModule = await fallbackModule
       }
 
-      // Initialize the module
-      this.wasmModule = await wasmModuleFactory.default()
-
-      // Create solver instance
-      this.wasmSolver = new this.wasmModule.PentominoSolver()
+      this.wasmSolver = nativeSolver(this.wasmModule)
 
       console.log('WebAssembly solver: Module loaded successfully!')
       return true
@@ -104,6 +139,8 @@ export class WebAssemblySolver {
       // Initialize WASM solver
       this.wasmSolver.init_board(board.config.width, board.config.height, blockedCells)
       this.wasmSolver.set_config(this.config.maxSolutions || 1, this.config.maxTime || 30000)
+      // Older modules have no algorithm selection and always backtrack
+      this.wasmSolver.set_algorithm?.(this.config.algorithm)
 
       // Solve using WASM
       const wasmResult = this.wasmSolver.solve()
@@ -228,8 +265,15 @@ export class WebAssemblySolver {
    * Check if WebAssembly is supported in the current environment
    */
   static isSupported(): boolean {
-    return typeof WebAssembly !== 'undefined' && 
-           typeof WebAssembly.instantiate === 'function'
+    return isWasmSupported()
+  }
+
+  /**
+   * Check if the runtime supports WebAssembly SIMD128.
+   * Validates a minimal module whose only function uses v128 instructions.
+   */
+  static isSimdSupported(): boolean {
+    return isSimdSupported()
   }
 
   /**
@@ -249,7 +293,8 @@ export class WebAssemblySolver {
         'Optimized algorithms with minimal overhead',
         'Memory-efficient data structures',
         'Parallel processing capabilities',
-        'Cross-platform compatibility'
+        'Cross-platform compatibility',
+        ...(this.isSimdSupported() ? ['SIMD128 batch placement testing'] : [])
       ] : [],
       limitations: supported ? [
         'Requires compilation step for algorithm changes',
@@ -0,0 +1,227 @@
+import { describe, it, expect, beforeEach } from 'vitest'
+import { RawWasmSolver, isRawSolverModule, type RawSolverModule } from '../RawWasmSolver'
+
+// pentomino_result as the lean module writes it (wasm/pentomino.h)
+interface FakeResult {
+  success: number
+  timedOut: number
+  solutions: bigint
+  nodes: bigint
+  solvingMs: bigint
+  engine: string
+}
+
+// Lean module over a plain Uint8Array heap: a bump allocator, the exports
+// recording what they were passed, solve() writing `nextResult` and
+// get_board() filling `boardCells` cells with 7
+function createFakeModule() {
+  const heap = new Uint8Array(4096)
+  let top = 8
+  const strings = new Map<string, number>()
+
+  const writeString = (text: string, pointer: number) => {
+    const bytes = new TextEncoder().encode(text)
+    heap.set(bytes, pointer)
+    heap[pointer + bytes.length] = 0
+  }
+  const staticString = (text: string) => {
+    let pointer = strings.get(text)
+    if (pointer === undefined) {
+      pointer = fake._malloc(text.length + 1)
+      writeString(text, pointer)
+      strings.set(text, pointer)
+    }
+    return pointer
+  }
+  const writeResult = (pointer: number) => {
+    const view = new DataView(heap.buffer)
+    view.setInt32(pointer, fake.nextResult.success, true)
+    view.setInt32(pointer + 4, fake.nextResult.timedOut, true)
+    view.setBigInt64(pointer + 8, fake.nextResult.solutions, true)
+    view.setBigInt64(pointer + 16, fake.nextResult.nodes, true)
+    view.setBigInt64(pointer + 24, fake.nextResult.solvingMs, true)
+    view.setUint32(pointer + 32, staticString(fake.nextResult.engine), true)
+    return fake.nextStatus
+  }
+
+  const fake = {
+    HEAPU8: heap,
+    nextStatus: 0,
+    limitsStatus: 0,
+    boardCells: 0,
+    nextResult: { success: 1, timedOut: 0, solutions: 0n, nodes: 0n, solvingMs: 0n, engine: 'bitboard' } as FakeResult,
+    error: 'no solution',
+    blocked: [] as number[],
+    limits: [] as number[],
+    nodeLimit: null as bigint | null,
+    stepBudget: null as bigint | null,
+
+    UTF8ToString(pointer: number) {
+      let end = pointer
+      while (heap[end] !== 0) end++
+      return new TextDecoder().decode(heap.subarray(pointer, end))
+    },
+    stringToUTF8(text: string, pointer: number) { writeString(text, pointer) },
+    lengthBytesUTF8(text: string) { return new TextEncoder().encode(text).length },
+    _malloc(size: number) {
+      const pointer = top
+      top += (size + 7) & ~7
+      return pointer
+    },
+    _free() {},
+    _pentomino_create: () => 1,
+    _pentomino_destroy() {},
+    _pentomino_last_error: () => staticString(fake.error),
+    _pentomino_set_board(_solver: number, width: number, height: number, blocked: number) {
+      if (width <= 0 || height <= 0) {
+        fake.error = 'Invalid board size'
+        return -2
+      }
+      fake.blocked = Array.from(heap.subarray(blocked, blocked + Math.ceil((width * height) / 8)))
+      return 0
+    },
+    _pentomino_set_piece_counts: () => 0,
+    _pentomino_set_algorithm: () => 0,
+    _pentomino_set_limits(_solver: number, maxSolutions: number, maxTimeMs: number) {
+      fake.limits = [maxSolutions, maxTimeMs]
+      if (fake.limitsStatus !== 0) fake.error = 'Negative limit'
+      return fake.limitsStatus
+    },
+    _pentomino_set_node_limit(_solver: number, maxNodes: bigint) {
+      fake.nodeLimit = maxNodes
+      return 0
+    },
+    _pentomino_set_deterministic: () => 0,
+    _pentomino_set_solution_capacity: () => 0,
+    _pentomino_solve: (_solver: number, result: number) => writeResult(result),
+    _pentomino_start: () => 0,
+    _pentomino_step(_solver: number, nodeBudget: bigint) {
+      fake.stepBudget = nodeBudget
+      return 1
+    },
+    _pentomino_get_result: (_solver: number, result: number) => writeResult(result),
+    _pentomino_stop() {},
+    _pentomino_get_progress: () => 0,
+    _pentomino_get_board(_solver: number, cells: number) {
+      new Int32Array(heap.buffer, cells, fake.boardCells).fill(7)
+      return 0
+    },
+  }
+  return fake
+}
+
+describe('RawWasmSolver', () => {
+  let fake: ReturnType<typeof createFakeModule>
+  let solver: RawWasmSolver
+
+  beforeEach(() => {
+    fake = createFakeModule()
+    solver = new RawWasmSolver(fake as RawSolverModule)
+  })
+
+  it('should recognize the lean module by its C exports', () => {
+    expect(isRawSolverModule(fake)).toBe(true)
+    expect(isRawSolverModule({ PentominoSolver: class {} })).toBe(false)
+    expect(isRawSolverModule(null)).toBe(false)
+  })
+
+  describe('Board mask', () => {
+    it('should pack blocked cells row-major, least significant bit first', () => {
+      // 8x8 center: bits 27, 28, 35 and 36
+      solver.init_board(8, 8, [{ x: 3, y: 3 }, { x: 4, y: 3 }, { x: 3, y: 4 }, { x: 4, y: 4 }])
+      expect(fake.blocked).toEqual([0, 0, 0, 0x18, 0x18, 0, 0, 0])
+    })
+
+    it('should pad the last byte and ignore cells off the board', () => {
+      solver.init_board(3, 3, [{ x: 2, y: 2 }, { x: 3, y: 0 }, { x: -1, y: 1 }, { x: 0, y: 3 }])
+      expect(fake.blocked).toEqual([0, 0x01])
+    })
+
+    it('should clear the mask left over from a previous board', () => {
+      solver.init_board(4, 4, [{ x: 0, y: 0 }, { x: 3, y: 3 }])
+      solver.init_board(4, 4, [{ x: 1, y: 0 }])
+      expect(fake.blocked).toEqual([0x02, 0])
+    })
+
+    it('should throw on a board the module rejects and keep the previous one', () => {
+      solver.init_board(2, 3, [])
+      expect(() => solver.init_board(0, 5, [])).toThrow('Invalid board size')
+      fake.boardCells = 6
+      expect(solver.get_board()).toEqual([[7, 7], [7, 7], [7, 7]])
+    })
+  })
+
+  describe('Limits', () => {
+    it('should pass the node limit as a BigInt, 0 when unlimited', () => {
+      solver.set_config(1, 30000)
+      expect(fake.limits).toEqual([1, 30000])
+      expect(fake.nodeLimit).toBe(0n)
+
+      solver.set_config(5, 1000, 2 ** 40 + 0.5)
+      expect(fake.nodeLimit).toBe(2n ** 40n)
+
+      solver.set_config(-1, -1, -5)
+      expect(fake.limits).toEqual([0, 0])
+      expect(fake.nodeLimit).toBe(0n)
+    })
+
+    it('should throw when the module rejects the limits', () => {
+      fake.limitsStatus = -2
+      expect(() => solver.set_config(1, 30000)).toThrow('Negative limit')
+      expect(fake.nodeLimit).toBeNull()
+    })
+
+    it('should pass the step budget as a BigInt', () => {
+      expect(solver.start()).toBe(true)
+      expect(solver.step(100000.7)).toBe(true)
+      expect(fake.stepBudget).toBe(100000n)
+    })
+  })
+
+  describe('Results', () => {
+    it('should read pentomino_result at offsets 0/4/8/16/24/32', () => {
+      fake.nextResult = {
+        success: 1,
+        timedOut: 0,
+        solutions: 2339n,
+        nodes: 2n ** 33n + 7n,
+        solvingMs: 1234n,
+        engine: 'rowset',
+      }
+      expect(solver.solve()).toEqual({
+        success: true,
+        solutions_found: 2339,
+        steps_explored: 2 ** 33 + 7,
+        solving_time: 1234,
+        engine: 'rowset',
+      })
+    })
+
+    it('should map timed_out to timeout or node_limit', () => {
+      fake.nextResult = { ...fake.nextResult, solutions: 3n, timedOut: 1 }
+      const timedOut = solver.solve()
+      expect(timedOut.timeout).toBe(true)
+      expect(timedOut.node_limit).toBeUndefined()
+
+      fake.nextResult = { ...fake.nextResult, timedOut: 2 }
+      const nodeLimit = solver.result()
+      expect(nodeLimit.node_limit).toBe(true)
+      expect(nodeLimit.timeout).toBeUndefined()
+    })
+
+    it('should report the last error when there is no solution', () => {
+      fake.nextResult = { ...fake.nextResult, success: 0 }
+      const result = solver.solve()
+      expect(result.success).toBe(false)
+      expect(result.error).toBe('no solution')
+    })
+
+    it('should fail when the call itself fails', () => {
+      fake.nextStatus = -1
+      fake.error = 'board not set'
+      const result = solver.solve()
+      expect(result.success).toBe(false)
+      expect(result.error).toBe('board not set')
+    })
+  })
+})
@@ -0,0 +1,163 @@
+/**
+ * Startup pipeline for the WebAssembly solver
+ *
+ * The .wasm is fetched and compiled with WebAssembly.compileStreaming once per
+ * page, starting at page load (preloadWasm), so compilation overlaps the
+ * download and the rest of startup. The compiled WebAssembly.Module is cached:
+ * every solver on the page shares one instance of it, and workers can be
+ * posted the Module and instantiate it without compiling again
+ * (instantiateSolverModule).
+ */
+
+export interface WasmBuild {
+  script: string   // Emscripten glue, exports the module factory
+  wasm: string
+}
+
+export interface WasmStartupStats {
+  build: string
+  bytes: number            // transferred size as reported by Content-Length, 0 if unknown
+  compileMs: number        // fetch + compile, overlapped when streaming
+  instantiateMs: number    // 0 until the module is instantiated
+  streaming: boolean
+}
+
+interface CompiledBuild {
+  build: WasmBuild
+  module: WebAssembly.Module
+}
+
+// Smallest module using SIMD128, used for feature detection:
+// (func (result v128) i32.const 0 i8x16.splat i8x16.popcnt)
+const SIMD_PROBE_MODULE = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0,
+  10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11
+])
+
+let simdSupported: boolean | null = null
+let compiled: Promise<CompiledBuild> | null = null
+let instance: Promise<unknown> | null = null
+let stats: WasmStartupStats | null = null
+
+export function isWasmSupported(): boolean {
+  return typeof WebAssembly !== 'undefined' && typeof WebAssembly.instantiate === 'function'
+}
+
+export function isSimdSupported(): boolean {
+  if (simdSupported === null) {
+    try {
+      simdSupported = isWasmSupported() && WebAssembly.validate(SIMD_PROBE_MODULE)
+    } catch {
+      simdSupported = false
+    }
+  }
+  return simdSupported
+}
+
+/**
+ * Builds to try, best first: lean (raw C exports) before embind, SIMD128
+ * before baseline. The -Oz lean builds (make oz) are used where they are
+ * deployed instead of the -O3 ones.
+ */
+export function candidateBuilds(): WasmBuild[] {
+  const names = isSimdSupported()
+    ? ['pentomino_lean_simd', 'pentomino_lean_simd_oz', 'pentomino_lean', 'pentomino_lean_oz',
+       'pentomino_solver_simd', 'pentomino_solver']
+    : ['pentomino_lean', 'pentomino_lean_oz', 'pentomino_solver']
+  return names.map(name => ({ script: `/wasm/${name}.js`, wasm: `/wasm/${name}.wasm` }))
+}
+
+async function compileBuild(build: WasmBuild): Promise<{ module: WebAssembly.Module, bytes: number, streaming: boolean }> {
+  const response = await fetch(build.wasm)
+  if (!response.ok) throw new Error(`${build.wasm}: HTTP ${response.status}`)
+  const bytes = Number(response.headers.get('Content-Length')) || 0
+  // compileStreaming requires the application/wasm MIME type; some static servers lack it
+  if (typeof WebAssembly.compileStreaming === 'function' &&
+      response.headers.get('Content-Type')?.startsWith('application/wasm')) {
+    return { module: await WebAssembly.compileStreaming(response), bytes, streaming: true }
+  }
+  const buffer = await response.arrayBuffer()
+  return { module: await WebAssembly.compile(buffer), bytes: buffer.byteLength, streaming: false }
+}
+
+async function compileFirstAvailable(): Promise<CompiledBuild> {
+  for (const build of candidateBuilds()) {
+    const start = performance.now()
+    try {
+      const { module, bytes, streaming } = await compileBuild(build)
+      stats = { build: build.wasm, bytes, compileMs: performance.now() - start, instantiateMs: 0, streaming }
+      return { build, module }
+    } catch {
+      // Not deployed (or not valid wasm, e.g. a dev server's index.html): try the next build
+    }
+  }
+  throw new Error('No WebAssembly solver build could be compiled')
+}
+
+/**
+ * Start fetching and compiling the best available build; call at page load.
+ * Repeated calls share the first one, unless it failed.
+ */
+export function preloadWasm(): Promise<CompiledBuild> {
+  if (!compiled) {
+    compiled = compileFirstAvailable()
+    compiled.catch(() => { compiled = null })
+  }
+  return compiled
+}
+
+/**
+ * The compiled module, e.g. to post to a worker, which then calls
+ * instantiateSolverModule() with it instead of compiling again
+ */
+export async function getCompiledModule(): Promise<{ module: WebAssembly.Module, script: string }> {
+  const { build, module } = await preloadWasm()
+  return { module, script: build.script }
+}
+
+/**
+ * Run the Emscripten factory of `script` on an already compiled module:
+ * its instantiateWasm hook replaces the factory's own fetch and compile.
+ * Rejects when instantiation fails, which the factory itself never reports
+ */
+export async function instantiateSolverModule(module: WebAssembly.Module, script: string): Promise<unknown> {
+  const factory = (await import(/* @vite-ignore */ script)).default
+  let fail: (error: unknown) => void = () => {}
+  const failed = new Promise<never>((_, reject) => { fail = reject })
+  return Promise.race([
+    factory({
+      instantiateWasm(imports: WebAssembly.Imports,
+                      receiveInstance: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void) {
+        WebAssembly.instantiate(module, imports)
+          .then(instance => receiveInstance(instance, module))
+          .catch(fail)
+        return {}
+      }
+    }),
+    failed
+  ])
+}
+
+/**
+ * The page's instance of the solver module, created on first use
+ */
+export function loadSolverModule(): Promise<unknown> {
+  if (!instance) {
+    instance = (async () => {
+      const { build, module } = await preloadWasm()
+      const start = performance.now()
+      const loaded = await instantiateSolverModule(module, build.script)
+      if (stats) stats.instantiateMs = performance.now() - start
+      return loaded
+    })()
+    instance.catch(() => { instance = null })
+  }
+  return instance
+}
+
+/**
+ * Timings of the page's module so far, null before it compiled
+ */
+export function getStartupStats(): WasmStartupStats | null {
+  return stats ? { ...stats } : null
+}
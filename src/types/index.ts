@@ -78,7 +78,7 @@ export interface Board {
 }
 
 // Solver types
-export type SolverAlgorithm = 'backtracking' | 'dancing-links'
+export type SolverAlgorithm = 'backtracking' | 'dancing-links' | 'dancing-cells' | 'bit-parallel' | 'hybrid'
 export type SolverEngine = 'javascript' | 'webassembly'
 
 export interface SolverConfig {
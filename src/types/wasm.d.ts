@@ -7,11 +7,14 @@ declare module '/wasm/pentomino_solver.js' {
     new(): any
     init_board(width: number, height: number, blocked_cells: Array<{x: number, y: number}>): void
     set_config(max_solutions: number, max_time: number): void
+    set_piece_counts?(counts: number[]): void
+    set_algorithm?(algorithm: string): boolean
     solve(): {
       success: boolean
       solutions_found: number
       steps_explored: number
       solving_time: number
+      engine?: string
       timeout?: boolean
       error?: string
     }
@@ -24,26 +27,57 @@ declare module '/wasm/pentomino_solver.js' {
     }
   }
 
+  interface BatchSolverWasm {
+    add_board(width: number, height: number, blocked_cells: Array<{x: number, y: number}>,
+      piece_counts: number[], max_solutions: number): number
+    clear(): void
+    size(): number
+    set_config(max_time: number): void
+    solve(): Array<{
+      success: boolean
+      solutions_found: number
+      steps_explored: number
+      solving_time: number
+      engine?: string
+      timeout?: boolean
+      error?: string
+      board: number[][]
+    }>
+    stop(): void
+  }
+
   interface PentominoSolverModule {
     PentominoSolver: {
       new(): PentominoSolverWasm
     }
+    BatchSolver?: {
+      new(): BatchSolverWasm
+    }
   }
 
   const factory: () => Promise<PentominoSolverModule>
   export default factory
 }
 
+declare module '/wasm/pentomino_lean.js' {
+  // Raw C exports, see src/solvers/RawWasmSolver.ts
+  const factory: () => Promise<import('../solvers/RawWasmSolver').RawSolverModule>
+  export default factory
+}
+
 declare module '/wasm/fallback.js' {
   interface FallbackSolver {
     new(): any
     init_board(width: number, height: number, blocked_cells: Array<{x: number, y: number}>): void
     set_config(max_solutions: number, max_time: number): void
+    set_piece_counts?(counts: number[]): void
+    set_algorithm?(algorithm: string): boolean
     solve(): {
       success: boolean
       solutions_found: number
       steps_explored: number
       solving_time: number
+      engine?: string
       timeout?: boolean
       error?: string
     }
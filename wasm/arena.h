@@ -0,0 +1,122 @@
+#ifndef PENTOMINO_ARENA_H
+#define PENTOMINO_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for per-board and per-solve data. Allocation is a pointer
+// bump; nothing is freed individually. rewind() drops everything allocated
+// since a mark and reset() drops everything, keeping the memory for reuse.
+// When a reset finds the data spread over several chunks they are replaced by
+// one chunk of the combined size, so after a warm-up solve the arena serves
+// every later board of similar size from a single chunk, without touching the
+// heap (and without growing WebAssembly memory).
+class Arena {
+public:
+    // Position to rewind to; only valid until the next reset()
+    struct Mark {
+        size_t chunk;
+        size_t used;
+    };
+
+    static constexpr size_t MIN_CHUNK = 64 * 1024;
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        for (auto& chunk : chunks_) std::free(chunk.data);
+    }
+
+    // Uninitialized storage for count objects of a trivial type
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                      "arena memory is never destructed");
+        return static_cast<T*>(allocate_bytes(count * sizeof(T), alignof(T)));
+    }
+
+    template <typename T>
+    T* allocate_filled(size_t count, const T& value) {
+        T* data = allocate<T>(count);
+        for (size_t i = 0; i < count; i++) data[i] = value;
+        return data;
+    }
+
+    Mark mark() const {
+        return {current_, chunks_.empty() ? 0 : chunks_[current_].used};
+    }
+
+    void rewind(const Mark& mark) {
+        if (chunks_.empty()) return;
+        for (size_t i = mark.chunk + 1; i <= current_; i++) chunks_[i].used = 0;
+        current_ = mark.chunk;
+        chunks_[current_].used = mark.used;
+    }
+
+    void reset() {
+        if (chunks_.size() > 1) {
+            size_t total = 0;
+            for (auto& chunk : chunks_) {
+                total += chunk.size;
+                std::free(chunk.data);
+            }
+            chunks_.clear();
+            add_chunk(total);
+        }
+        current_ = 0;
+        if (!chunks_.empty()) chunks_[0].used = 0;
+    }
+
+    // Bytes held from the heap
+    size_t capacity() const {
+        size_t total = 0;
+        for (const auto& chunk : chunks_) total += chunk.size;
+        return total;
+    }
+
+private:
+    struct Chunk {
+        unsigned char* data;
+        size_t size;
+        size_t used;
+    };
+
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;
+
+    void add_chunk(size_t size) {
+        if (size < MIN_CHUNK) size = MIN_CHUNK;
+        void* data = std::malloc(size);
+        if (!data) throw std::bad_alloc();
+        chunks_.push_back({static_cast<unsigned char*>(data), size, 0});
+    }
+
+    void* allocate_bytes(size_t bytes, size_t align) {
+        for (;;) {
+            if (current_ < chunks_.size()) {
+                Chunk& chunk = chunks_[current_];
+                uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data);
+                size_t offset = ((base + chunk.used + align - 1) & ~(uintptr_t)(align - 1)) - base;
+                if (offset + bytes <= chunk.size) {
+                    chunk.used = offset + bytes;
+                    return chunk.data + offset;
+                }
+                if (current_ + 1 < chunks_.size()) {
+                    chunks_[++current_].used = 0;
+                    continue;
+                }
+            }
+            size_t last = chunks_.empty() ? 0 : chunks_.back().size;
+            add_chunk(bytes + align > 2 * last ? bytes + align : 2 * last);
+            current_ = chunks_.size() - 1;
+        }
+    }
+};
+
+#endif // PENTOMINO_ARENA_H
@@ -0,0 +1,184 @@
+#ifndef PENTOMINO_BATCH_SOLVER_H
+#define PENTOMINO_BATCH_SOLVER_H
+
+#include <vector>
+#include <array>
+#include <chrono>
+#include <string>
+#include "pentomino_solver.h"
+#include "lane_engine.h"
+
+// Outcome of one board of a batch; board holds the first solution found
+struct BatchBoardResult {
+    SolveResult result;
+    std::vector<std::vector<int>> board;
+};
+
+// Solves many independent boards, e.g. uniqueness checks over every Katamino
+// piece subset. Small boards (<= 64 cells, each piece at most once) go through
+// LaneBatchEngine when it is the faster option on this host (AVX-512);
+// everything else, and every board on other hosts and WebAssembly builds, is
+// solved one by one with a single PentominoSolver, whose arena makes boards
+// after the first allocation-free. The time limit covers the whole batch.
+class BatchSolver {
+private:
+    struct Entry {
+        int width;
+        int height;
+        std::vector<std::pair<int, int>> blocked;
+        std::vector<int> piece_counts;
+        int max_solutions;
+    };
+
+    std::vector<Entry> entries;
+    OrientationTable all_orientations;
+    LaneBatchEngine lanes;
+    PentominoSolver general;  // reused so its arena stays warm across boards
+    int max_time_ms;
+    std::atomic<bool> should_stop;
+
+    static std::vector<std::vector<int>> empty_board(const Entry& entry) {
+        std::vector<std::vector<int>> board(entry.height, std::vector<int>(entry.width, -1));
+        for (const auto& cell : entry.blocked) {
+            if (cell.first >= 0 && cell.first < entry.width &&
+                cell.second >= 0 && cell.second < entry.height) {
+                board[cell.second][cell.first] = -2;
+            }
+        }
+        return board;
+    }
+
+    // Lane form of an entry, or false when it needs the general solver
+    static bool to_lane_board(const Entry& entry, const std::vector<std::vector<int>>& board,
+                              LaneBoard& lane) {
+        lane.width = entry.width;
+        lane.height = entry.height;
+        if (!LaneBatchEngine::fits(lane)) return false;
+
+        int empty_cells = 0;
+        lane.open.assign(entry.width * entry.height, 0);
+        for (int y = 0; y < entry.height; y++) {
+            for (int x = 0; x < entry.width; x++) {
+                lane.open[y * entry.width + x] = board[y][x] == -1;
+                empty_cells += board[y][x] == -1;
+            }
+        }
+
+        // Without explicit counts a 60-cell board takes one whole set
+        lane.pieces = 0;
+        int total = 0;
+        for (int p = 0; p < PIECE_TYPES; p++) {
+            int count = entry.piece_counts.empty() ? 1
+                : p < static_cast<int>(entry.piece_counts.size()) ? std::max(0, entry.piece_counts[p]) : 0;
+            if (count > 1) return false;
+            lane.pieces |= static_cast<uint32_t>(count) << p;
+            total += count;
+        }
+        lane.max_solutions = entry.max_solutions;
+        return empty_cells == total * PIECE_CELLS;
+    }
+
+    long long elapsed_ms(std::chrono::steady_clock::time_point start) const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+public:
+    BatchSolver() : max_time_ms(0), should_stop(false) {
+        all_orientations = build_orientation_table();
+    }
+
+    // Queue a board; returns its index in the results
+    int add_board(int width, int height, const std::vector<std::pair<int, int>>& blocked_cells,
+                  const std::vector<int>& piece_counts, int max_solutions) {
+        entries.push_back({width, height, blocked_cells, piece_counts, max_solutions});
+        return static_cast<int>(entries.size()) - 1;
+    }
+
+    void clear() {
+        entries.clear();
+    }
+
+    int size() const {
+        return static_cast<int>(entries.size());
+    }
+
+    // Time limit for the whole batch (0 = unlimited)
+    void set_config(int max_time) {
+        max_time_ms = max_time;
+    }
+
+    void stop() {
+        should_stop = true;
+        general.stop();
+    }
+
+    std::vector<BatchBoardResult> solve() {
+        should_stop = false;
+        auto start_time = std::chrono::steady_clock::now();
+
+        std::vector<BatchBoardResult> results(entries.size());
+        std::vector<LaneBoard> lane_boards;
+        std::vector<int> lane_entries;
+        std::vector<int> general_entries;
+
+        bool use_lanes = LaneBatchEngine::preferred();
+        for (size_t i = 0; i < entries.size(); i++) {
+            results[i].board = empty_board(entries[i]);
+            LaneBoard lane;
+            if (use_lanes && to_lane_board(entries[i], results[i].board, lane)) {
+                lane_boards.push_back(std::move(lane));
+                lane_entries.push_back(static_cast<int>(i));
+            } else {
+                general_entries.push_back(static_cast<int>(i));
+            }
+        }
+
+        SearchControl control;
+        control.max_time_ms = max_time_ms;
+        control.stop_flag = &should_stop;
+        control.start_time = start_time;
+
+        if (!lane_boards.empty()) {
+            std::vector<LaneResult> solved = lanes.solve(lane_boards, all_orientations, control);
+            long long batch_time = elapsed_ms(start_time);
+            for (size_t k = 0; k < lane_boards.size(); k++) {
+                BatchBoardResult& out = results[lane_entries[k]];
+                out.result.success = true;
+                out.result.engine = "lanes";
+                out.result.solutions_found = solved[k].solutions;
+                out.result.steps_explored = solved[k].nodes;
+                out.result.solving_time = batch_time;
+                out.result.timeout = !solved[k].finished && control.timed_out;
+                for (const auto& placed : solved[k].first_solution) {
+                    for (int cell : placed.cells) {
+                        out.board[cell / lane_boards[k].width][cell % lane_boards[k].width] = placed.piece;
+                    }
+                }
+            }
+        }
+
+        for (int i : general_entries) {
+            const Entry& entry = entries[i];
+            long long remaining = max_time_ms > 0 ? max_time_ms - elapsed_ms(start_time) : 0;
+            if (should_stop || (max_time_ms > 0 && remaining <= 0)) {
+                results[i].result.timeout = max_time_ms > 0 && !should_stop;
+                continue;
+            }
+
+            general.init_board(entry.width, entry.height, entry.blocked);
+            general.set_piece_counts(entry.piece_counts);
+            general.set_config(entry.max_solutions, static_cast<int>(remaining));
+            results[i].result = general.solve();
+            const int* cells = general.get_cells();
+            for (int y = 0; y < entry.height; y++) {
+                for (int x = 0; x < entry.width; x++) {
+                    results[i].board[y][x] = cells[y * entry.width + x];
+                }
+            }
+        }
+        return results;
+    }
+};
+
+#endif // PENTOMINO_BATCH_SOLVER_H
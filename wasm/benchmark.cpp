@@ -0,0 +1,455 @@
+// Native benchmark harness for the pentomino engines.
+//
+// Runs the standard boards through PentominoSolver with each algorithm and
+// reports nodes/sec, plus instructions per cycle and L1, last-level cache and
+// branch misses per node where the kernel exposes hardware counters; then the
+// standard batches (uniqueness checks
+// over piece subsets) through BatchSolver and board by board for comparison.
+// Kernels are dispatched at runtime, so the same binary can be asked to run
+// the scalar, AVX2 or AVX-512 paths for comparison.
+//
+//   pentomino_bench                        all boards and batches, best ISA for this host
+//   pentomino_bench --isa scalar           force a kernel ISA
+//   pentomino_bench --board 6x10 -r 5      one board, best of 5 runs
+//   pentomino_bench --board katamino-5xk   one batch
+//   pentomino_bench --algorithm dancing-links  one algorithm
+//   pentomino_bench --split-sweep          hybrid time per DLX split depth, for tuning
+//   pentomino_bench --threads 4 --max-solutions 100   ParallelSolver, exact global limit
+//   pentomino_bench --max-nodes 1000000    each board stops at a fixed node count
+//   pentomino_bench --list                 list the standard boards and batches
+//   pentomino_bench --baseline OTHER_BIN   speedup over another build (e.g. make bench-pgo)
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "pentomino_solver.h"
+#include "batch_solver.h"
+#include "parallel_solver.h"
+#include "perf_counters.h"
+
+struct BenchmarkBoard {
+    const char* name;
+    int width;
+    int height;
+    std::vector<std::pair<int, int>> blocked;
+    int max_solutions;  // 0 = enumerate all
+    const char* expected;
+};
+
+static const std::vector<BenchmarkBoard>& standard_boards() {
+    static const std::vector<BenchmarkBoard> boards = {
+        {"6x10", 10, 6, {}, 0, "9356 solutions"},
+        {"5x12", 12, 5, {}, 0, "4040 solutions"},
+        {"4x15", 15, 4, {}, 0, "1472 solutions"},
+        {"3x20", 20, 3, {}, 0, "8 solutions"},
+        {"8x8-center", 8, 8, {{3, 3}, {4, 3}, {3, 4}, {4, 4}}, 0, "520 solutions"},
+        // 60 open cells, but the corner (0, 0) is walled in: no placement covers it
+        {"8x8-uncoverable", 8, 8, {{1, 0}, {0, 1}, {6, 7}, {7, 7}}, 0, "0 solutions"},
+        {"5x24-double", 24, 5, {}, 2000, "128-bit board"},
+        {"5x36-triple", 36, 5, {}, 1, "192-bit board"},
+        {"10x24-quadruple", 24, 10, {}, 1, "256-bit board"},
+        {"6x50-quintuple", 50, 6, {}, 1, "512-bit board"},
+        {"10x30-quintuple", 30, 10, {}, 1, "512-bit board"},
+    };
+    return boards;
+}
+
+// A batch of full-rectangle boards: every subset of `pieces` pieces on a
+// height x (5 * pieces / height) rectangle, checked for a unique solution.
+// Solutions are counted with their rotations and reflections, so a board is
+// unique when it has exactly as many solutions as the rectangle has symmetries.
+struct BenchmarkBatch {
+    const char* name;
+    std::vector<std::pair<int, int>> shapes;  // (height, pieces)
+    const char* expected;
+};
+
+static const std::vector<BenchmarkBatch>& standard_batches() {
+    static const std::vector<BenchmarkBatch> batches = {
+        {"katamino-5xk", {{5, 5}, {5, 6}, {5, 7}, {5, 8}}, "3003 boards"},
+        {"3xk", {{3, 6}, {3, 9}, {3, 12}}, "1145 boards"},
+    };
+    return batches;
+}
+
+struct BatchBoard {
+    int width;
+    int height;
+    std::vector<int> counts;
+    int symmetries;
+};
+
+static std::vector<BatchBoard> batch_boards(const BenchmarkBatch& batch) {
+    std::vector<BatchBoard> boards;
+    for (const auto& shape : batch.shapes) {
+        int height = shape.first;
+        int width = shape.second * PIECE_CELLS / height;
+        for (uint32_t subset = 0; subset < (1u << PIECE_TYPES); subset++) {
+            if (__builtin_popcount(subset) != shape.second) continue;
+            std::vector<int> counts(PIECE_TYPES);
+            for (int p = 0; p < PIECE_TYPES; p++) counts[p] = (subset >> p) & 1;
+            boards.push_back({width, height, counts, width == height ? 8 : 4});
+        }
+    }
+    return boards;
+}
+
+struct BenchmarkRun {
+    SolveResult result;
+    double ms;
+    PerfSample counters;
+};
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Deterministic (no clock reads in the search), so every run of a board with
+// an algorithm explores the same nodes; max_nodes > 0 cuts each board there
+static BenchmarkRun run_board(const BenchmarkBoard& board, SolverAlgorithm algorithm,
+                              PerfCounterSet& counters, int split_depth = -1, long long max_nodes = 0) {
+    PentominoSolver solver;
+    solver.init_board(board.width, board.height, board.blocked);
+    solver.set_algorithm(solver_algorithm_name(algorithm));
+    solver.set_split_depth(split_depth);
+    solver.set_config(board.max_solutions, 0, max_nodes);
+    solver.set_deterministic(true);
+
+    auto start = std::chrono::steady_clock::now();
+    counters.start();
+    SolveResult result = solver.solve();
+    PerfSample sample = counters.stop();
+    return {result, elapsed_ms(start), sample};
+}
+
+// Counter columns of a board row, "n/a" for events the host cannot count
+struct PerfColumns {
+    char ipc[16] = "n/a";
+    char l1_misses[16] = "n/a";
+    char llc_misses[16] = "n/a";
+    char branch_misses[16] = "n/a";
+};
+
+static PerfColumns perf_columns(const PerfCounterSet& counters, const PerfSample& sample, long long nodes) {
+    PerfColumns columns;
+    uint64_t cycles = sample[PerfEvent::CYCLES];
+    if (counters.available(PerfEvent::CYCLES) && counters.available(PerfEvent::INSTRUCTIONS) && cycles > 0) {
+        std::snprintf(columns.ipc, sizeof(columns.ipc), "%.2f",
+                      static_cast<double>(sample[PerfEvent::INSTRUCTIONS]) / cycles);
+    }
+    auto per_node = [&](PerfEvent event, char* out) {
+        if (counters.available(event) && nodes > 0) {
+            std::snprintf(out, 16, "%.2f", static_cast<double>(sample[event]) / nodes);
+        }
+    };
+    per_node(PerfEvent::L1D_MISSES, columns.l1_misses);
+    per_node(PerfEvent::CACHE_MISSES, columns.llc_misses);
+    per_node(PerfEvent::BRANCH_MISSES, columns.branch_misses);
+    return columns;
+}
+
+// Whether a run used the algorithm asked for rather than falling back to backtracking
+static bool ran_as(SolverAlgorithm algorithm, const SolveResult& result) {
+    return algorithm == SolverAlgorithm::BACKTRACKING ||
+           (std::strcmp(result.engine, "bitboard") != 0 && std::strcmp(result.engine, "grid") != 0);
+}
+
+// Hybrid solve time for each split depth, fastest of `repeat` runs; the
+// table behind hybrid_split_depth() comes from this
+static void run_split_sweep(const BenchmarkBoard& board, int repeat, PerfCounterSet& counters) {
+    constexpr int MAX_SPLIT = 6;
+    double best_ms = 0;
+    int best_split = 0;
+    std::printf("%-18s", board.name);
+    for (int split = 0; split <= MAX_SPLIT; split++) {
+        double ms = 0;
+        for (int r = 0; r < repeat; r++) {
+            BenchmarkRun run = run_board(board, SolverAlgorithm::HYBRID, counters, split);
+            if (!run.result.success || std::strcmp(run.result.engine, "hybrid") != 0) {
+                std::printf(" %9s\n", "n/a");
+                return;
+            }
+            if (r == 0 || run.ms < ms) ms = run.ms;
+        }
+        if (split == 0 || ms < best_ms) {
+            best_ms = ms;
+            best_split = split;
+        }
+        std::printf(" %9.1f", ms);
+    }
+    int open = board.width * board.height - static_cast<int>(board.blocked.size());
+    std::printf(" %6d %6d\n", best_split, hybrid_split_depth(board.width, board.height, open));
+}
+
+// Batch through BatchSolver vs. the same boards one PentominoSolver at a time
+static void run_batch(const BenchmarkBatch& batch, int repeat) {
+    std::vector<BatchBoard> boards = batch_boards(batch);
+    BatchSolver solver;
+    for (const auto& board : boards) {
+        solver.add_board(board.width, board.height, {}, board.counts, board.symmetries + 1);
+    }
+
+    std::vector<BatchBoardResult> results;
+    double batch_ms = 0;
+    for (int r = 0; r < repeat; r++) {
+        auto start = std::chrono::steady_clock::now();
+        results = solver.solve();
+        double ms = elapsed_ms(start);
+        if (r == 0 || ms < batch_ms) batch_ms = ms;
+    }
+
+    double single_ms = 0;
+    int mismatches = 0;
+    for (int r = 0; r < repeat; r++) {
+        auto start = std::chrono::steady_clock::now();
+        PentominoSolver single;
+        for (size_t i = 0; i < boards.size(); i++) {
+            single.init_board(boards[i].width, boards[i].height, {});
+            single.set_piece_counts(boards[i].counts);
+            single.set_config(boards[i].symmetries + 1, 0);
+            mismatches += single.solve().solutions_found != results[i].result.solutions_found;
+        }
+        double ms = elapsed_ms(start);
+        if (r == 0 || ms < single_ms) single_ms = ms;
+    }
+
+    int unique = 0;
+    for (size_t i = 0; i < boards.size(); i++) {
+        unique += results[i].result.solutions_found == boards[i].symmetries;
+    }
+    std::printf("%-18s %8zu %8d %12.1f %12.1f %8.2fx%s\n", batch.name, boards.size(), unique,
+                batch_ms, single_ms, batch_ms > 0 ? single_ms / batch_ms : 0.0,
+                mismatches ? "  MISMATCH" : "");
+}
+
+// ParallelSolver on one board, fastest of `repeat` runs. The callback count
+// checks that a global limit is never overshot; the stop latency is how
+// long the other threads took to stop once the limit was reached.
+static void run_parallel(const BenchmarkBoard& board, int threads, int max_solutions, int repeat) {
+    SolveResult best;
+    double best_ms = 0;
+    long long best_reported = 0;
+    double best_latency = -1;
+    for (int r = 0; r < repeat; r++) {
+        ParallelSolver solver(threads);
+        solver.init_board(board.width, board.height, board.blocked);
+        solver.set_config(max_solutions, 0);
+        long long reported = 0;
+        solver.set_solution_callback([&](const PlacedPiece*, int) { reported++; });
+        auto start = std::chrono::steady_clock::now();
+        SolveResult result = solver.solve();
+        double ms = elapsed_ms(start);
+        if (r == 0 || ms < best_ms) {
+            best = result;
+            best_ms = ms;
+            best_reported = reported;
+            best_latency = solver.last_stop_latency_us();
+        }
+    }
+    if (!best.success) {
+        std::printf("%-18s error: %s\n", board.name, best.error.c_str());
+        return;
+    }
+    char latency[16] = "-";
+    if (best_latency >= 0) std::snprintf(latency, sizeof(latency), "%.1f", best_latency);
+    std::printf("%-18s %8d %10d %10lld %14lld %10.1f %12.2f %10s\n", board.name, threads, best.solutions_found,
+                best_reported, best.steps_explored, best_ms, best_ms > 0 ? best.steps_explored / (best_ms * 1000.0) : 0.0,
+                latency);
+}
+
+static bool is_selected(const std::vector<std::string>& selected, const char* name) {
+    return selected.empty() || std::find(selected.begin(), selected.end(), name) != selected.end();
+}
+
+// Board rows (board, algorithm, solutions, nodes, ms) of another build of
+// this harness run with the same options, keyed by "board algorithm"
+struct BaselineRow {
+    long long nodes;
+    double ms;
+};
+
+static std::map<std::string, BaselineRow> run_baseline(const std::string& binary,
+                                                       const std::vector<std::string>& args) {
+    std::string command = "'" + binary + "'";
+    for (const auto& arg : args) command += " '" + arg + "'";
+    std::map<std::string, BaselineRow> rows;
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) return rows;
+    char line[256];
+    while (std::fgets(line, sizeof(line), pipe)) {
+        char board[64], algorithm[32];
+        int solutions;
+        BaselineRow row;
+        if (std::sscanf(line, "%63s %31s %d %lld %lf", board, algorithm, &solutions, &row.nodes, &row.ms) == 5) {
+            rows[std::string(board) + " " + algorithm] = row;
+        }
+    }
+    if (pclose(pipe) != 0) rows.clear();
+    return rows;
+}
+
+static void print_usage() {
+    std::printf("usage: pentomino_bench [--isa scalar|avx2|avx512] [--board NAME]... "
+                "[--algorithm backtracking|dancing-links|dancing-cells|bit-parallel|hybrid]... "
+                "[--split-sweep] [--threads N [--max-solutions N]] [--max-nodes N] [-r REPEAT] [--baseline BIN] "
+                "[--list]\n");
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> selected;
+    std::vector<SolverAlgorithm> algorithms;
+    int repeat = 1;
+    bool split_sweep = false;
+    int threads = 0;
+    int max_solutions = -1;
+    long long max_nodes = 0;
+    const char* baseline = nullptr;
+    std::vector<std::string> forwarded;  // options for the baseline run
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline = argv[++i];
+            continue;
+        }
+        int first = i;
+        if (std::strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+            KernelIsa isa;
+            if (!parse_kernel_isa(argv[++i], isa) || !set_kernel_isa(isa)) {
+                std::fprintf(stderr, "ISA '%s' is not available on this host\n", argv[i]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+            selected.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+            SolverAlgorithm algorithm;
+            if (!parse_solver_algorithm(argv[++i], algorithm)) {
+                std::fprintf(stderr, "unknown algorithm '%s'\n", argv[i]);
+                return 1;
+            }
+            algorithms.push_back(algorithm);
+        } else if ((std::strcmp(argv[i], "-r") == 0 || std::strcmp(argv[i], "--repeat") == 0) && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-solutions") == 0 && i + 1 < argc) {
+            max_solutions = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+            max_nodes = std::max(0LL, std::atoll(argv[++i]));
+        } else if (std::strcmp(argv[i], "--split-sweep") == 0) {
+            split_sweep = true;
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            for (const auto& board : standard_boards()) {
+                std::printf("%-18s %dx%d  %s\n", board.name, board.width, board.height, board.expected);
+            }
+            for (const auto& batch : standard_batches()) {
+                std::printf("%-18s batch  %s\n", batch.name, batch.expected);
+            }
+            return 0;
+        } else {
+            print_usage();
+            return 1;
+        }
+        forwarded.insert(forwarded.end(), argv + first, argv + i + 1);
+    }
+
+    if (algorithms.empty()) {
+        algorithms = {SolverAlgorithm::BACKTRACKING, SolverAlgorithm::DANCING_LINKS,
+                      SolverAlgorithm::DANCING_CELLS, SolverAlgorithm::BIT_PARALLEL, SolverAlgorithm::HYBRID};
+    }
+    PerfCounterSet counters;
+
+    std::printf("kernel isa: %s (host best: %s)\n\n",
+                kernel_isa_name(active_kernel_isa()), kernel_isa_name(detect_kernel_isa()));
+
+    if (split_sweep) {
+        std::printf("%-18s", "board");
+        for (int split = 0; split <= 6; split++) std::printf("   split %d", split);
+        std::printf(" %6s %6s\n", "best", "auto");
+        for (const auto& board : standard_boards()) {
+            if (is_selected(selected, board.name)) run_split_sweep(board, repeat, counters);
+        }
+        return 0;
+    }
+    if (baseline && threads > 0) {
+        std::fprintf(stderr, "--baseline compares the single-threaded board table only\n");
+        return 1;
+    }
+    if (threads > 0) {
+        std::printf("%-18s %8s %10s %10s %14s %10s %12s %10s\n",
+                    "board", "threads", "solutions", "reported", "nodes", "ms", "Mnodes/s", "stop us");
+        for (const auto& board : standard_boards()) {
+            if (!is_selected(selected, board.name)) continue;
+            run_parallel(board, threads, max_solutions >= 0 ? max_solutions : board.max_solutions, repeat);
+        }
+        return 0;
+    }
+
+    // The baseline runs first, alone, so both builds see the same machine state
+    std::map<std::string, BaselineRow> base;
+    if (baseline) {
+        base = run_baseline(baseline, forwarded);
+        if (base.empty()) {
+            std::fprintf(stderr, "baseline '%s' failed or reported no boards\n", baseline);
+            return 1;
+        }
+    }
+
+    if (max_nodes > 0) std::printf("node limit: %lld per board\n\n", max_nodes);
+    if (!counters.any_available()) {
+        std::printf("hardware counters: not available (perf_event_paranoid, no PMU or not Linux)\n\n");
+    }
+    std::printf("%-18s %-14s %10s %14s %10s %12s %6s %8s %8s %8s%s\n",
+                "board", "algorithm", "solutions", "nodes", "ms", "Mnodes/s", "IPC", "L1/node", "LLC/node",
+                "br/node", baseline ? "   speedup" : "");
+
+    for (const auto& board : standard_boards()) {
+        if (!is_selected(selected, board.name)) continue;
+
+        for (SolverAlgorithm algorithm : algorithms) {
+            // Report the fastest of the repeated runs
+            BenchmarkRun best = run_board(board, algorithm, counters, -1, max_nodes);
+            if (best.result.success && !ran_as(algorithm, best.result)) continue;
+            for (int r = 1; r < repeat; r++) {
+                BenchmarkRun run = run_board(board, algorithm, counters, -1, max_nodes);
+                if (run.ms < best.ms) best = run;
+            }
+
+            const char* name = solver_algorithm_name(algorithm);
+            if (!best.result.success) {
+                std::printf("%-18s %-14s error: %s\n", board.name, name, best.result.error.c_str());
+                continue;
+            }
+            long long nodes = best.result.steps_explored;
+            double rate = best.ms > 0 ? nodes / (best.ms * 1000.0) : 0.0;
+            // Boards enumerated to the end must find the listed number of solutions
+            int expected = -1;
+            bool complete = board.max_solutions == 0 && !best.result.node_limit;
+            bool mismatch = complete && std::sscanf(board.expected, "%d solutions", &expected) == 1 &&
+                            expected != best.result.solutions_found;
+            PerfColumns columns = perf_columns(counters, best.counters, nodes);
+            std::printf("%-18s %-14s %10d %14lld %10.1f %12.2f %6s %8s %8s %8s", board.name, name,
+                        best.result.solutions_found, nodes, best.ms, rate, columns.ipc, columns.l1_misses,
+                        columns.llc_misses, columns.branch_misses);
+            if (baseline) {
+                auto row = base.find(std::string(board.name) + " " + name);
+                if (row == base.end() || best.ms <= 0) {
+                    std::printf(" %9s", "-");
+                } else {
+                    std::printf(" %8.2fx", row->second.ms / best.ms);
+                    // Both builds must search the same tree for the times to compare
+                    if (row->second.nodes != nodes) std::printf("  (baseline nodes %lld)", row->second.nodes);
+                }
+            }
+            std::printf("%s\n", mismatch ? "  MISMATCH" : "");
+        }
+    }
+
+    std::printf("\n%-18s %8s %8s %12s %12s %9s\n", "batch", "boards", "unique", "batch ms", "single ms", "speedup");
+    for (const auto& batch : standard_batches()) {
+        if (is_selected(selected, batch.name)) run_batch(batch, repeat);
+    }
+    return 0;
+}
@@ -0,0 +1,514 @@
+#ifndef PENTOMINO_BITBOARD_H
+#define PENTOMINO_BITBOARD_H
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include "solver_common.h"
+#include "arena.h"
+#include "placement_kernels.h"
+#include "region_kernels.h"
+
+// Fixed-size multi-word bitboard; bit i is cell i in the engine's linear layout
+template <int Words>
+struct Bitboard {
+    static constexpr int WORDS = Words;
+    static constexpr int BITS = Words * 64;
+
+    uint64_t w[Words];
+
+    void fill(uint64_t value) {
+        for (int i = 0; i < Words; i++) w[i] = value;
+    }
+
+    void set(int bit) { w[bit >> 6] |= 1ULL << (bit & 63); }
+    void reset(int bit) { w[bit >> 6] &= ~(1ULL << (bit & 63)); }
+    bool test(int bit) const { return (w[bit >> 6] >> (bit & 63)) & 1; }
+
+    // Index of the lowest clear bit, or -1 when every bit is set
+    int first_empty() const {
+        for (int i = 0; i < Words; i++) {
+            uint64_t free_bits = ~w[i];
+            if (free_bits) return i * 64 + __builtin_ctzll(free_bits);
+        }
+        return -1;
+    }
+
+    int count() const {
+        int total = 0;
+        for (int i = 0; i < Words; i++) total += __builtin_popcountll(w[i]);
+        return total;
+    }
+};
+
+// Consecutive board words a single placement mask may touch. A pentomino spans
+// at most five rows, so three words are enough for boards up to 31 cells wide.
+template <int Words>
+constexpr int placement_span() {
+    return Words < 3 ? Words : 3;
+}
+
+// First-empty-cell exact cover search over a Words * 64 bit occupancy mask.
+// Every placement is stored as a SPAN-word mask plus the board word it starts
+// at, so placing and testing a piece touches only the words it overlaps.
+template <int Words>
+class BitboardEngine {
+public:
+    static constexpr int SPAN = placement_span<Words>();
+    // 63 fixed orientations exist across the 12 pieces and each anchors once per cell
+    static constexpr int MAX_CANDIDATES = 64;
+
+    // Build placement tables for the board, allocated from the arena, which
+    // must outlive the engine. Returns false when the board does not fit this
+    // bitboard width, in which case the caller falls back to the grid.
+    bool setup(int width, int height, const uint8_t* open,
+               const OrientationTable& orientations,
+               const std::array<int, PIECE_TYPES>& counts, Arena& arena) {
+        width_ = width;
+        height_ = height;
+        counts_ = counts;
+        total_pieces_ = 0;
+        for (int c : counts) total_pieces_ += c;
+
+        if (width * height > Bitboard<Words>::BITS) return false;
+
+        // The first empty cell advances along the stride, and branching stays far
+        // lower when it walks the short side, so prefer that layout.
+        bool transpose = width > height;
+        Arena::Mark start = arena.mark();
+        if (!build_tables(transpose, open, orientations, arena)) {
+            arena.rewind(start);
+            if (!build_tables(!transpose, open, orientations, arena)) return false;
+        }
+        frames_ = arena.allocate<Frame>(total_pieces_);
+        solution_ = arena.allocate<PlacedPiece>(total_pieces_);
+
+        KernelIsa isa = active_kernel_isa();
+        filter_ = select_filter_kernel<SPAN>(isa);
+        region_size_ = select_region_kernel<Words>(isa);
+        return true;
+    }
+
+    void solve(SearchControl& control, const SolutionCallback& on_solution) {
+        solve_residual(nullptr, 0, control, on_solution);
+    }
+
+    // Search the board left after the given pieces are put down, reporting
+    // full solutions with those pieces first. The hybrid engine calls this
+    // below its split depth; the placements must come from the board's pieces.
+    void solve_residual(const PlacedPiece* placed, int count,
+                        SearchControl& control, const SolutionCallback& on_solution) {
+        if (begin_residual(placed, count)) resume(control, on_solution);
+    }
+
+    // Set up the search of solve_residual() without running it; false when
+    // there is nothing to search
+    bool begin_residual(const PlacedPiece* placed, int count) {
+        depth_ = -1;
+        placed_ = count;
+        total_ = total_pieces_ - count;
+        if (total_pieces_ == 0 || total_ <= 0) return false;
+
+        occupied_ = initial_;
+        remaining_ = counts_;
+        for (int i = 0; i < count; i++) {
+            solution_[i] = placed[i];
+            remaining_[placed[i].piece]--;
+            for (int c = 0; c < PIECE_CELLS; c++) occupied_.set(bit_of_cell(placed[i].cells[c]));
+        }
+        available_ = 0;
+        for (int p = 0; p < PIECE_TYPES; p++) {
+            if (remaining_[p] > 0) available_ |= 1u << p;
+        }
+
+        int anchor = occupied_.first_empty();
+        if (count > 0 && prune_regions_ && region_size_(occupied_.w, anchor, region_masks_) % PIECE_CELLS != 0) {
+            return false;
+        }
+        depth_ = 0;
+        open_frame(frames_[0], occupied_, anchor, available_);
+        frames_[0].opened = 0;
+        return true;
+    }
+
+    // Run a begun search until it is done or, when control.pause_at is set,
+    // until that many nodes have been counted. A paused search sets
+    // control.paused and keeps its whole state on the explicit stack, so the
+    // next resume() carries on from the same node.
+    void resume(SearchControl& control, const SolutionCallback& on_solution) {
+        // Work on locals and store them back on the way out, so the loop
+        // keeps them in registers as before
+        Bitboard<Words> occupied = occupied_;
+        std::array<int, PIECE_TYPES> remaining = remaining_;
+        uint32_t available = available_;
+        int depth = depth_;
+        const int total = total_;
+        const int count = placed_;
+        const long long pause_at = control.pause_at > 0 ? control.pause_at : LLONG_MAX;
+
+        while (depth >= 0) {
+            if (control.nodes >= pause_at) {
+                control.paused = true;
+                break;
+            }
+            Frame& frame = frames_[depth];
+
+            // Undo the alternative tried last at this depth
+            if (frame.next > 0) {
+                int previous = frame.cand[frame.next - 1];
+                toggle(occupied, previous);
+                int piece = piece_[previous];
+                remaining[piece]++;
+                available |= 1u << piece;
+            }
+
+            if (frame.next == frame.count) {
+                depth--;
+                continue;
+            }
+
+            int id = frame.cand[frame.next++];
+            toggle(occupied, id);
+            int piece = piece_[id];
+            if (--remaining[piece] == 0) available &= ~(1u << piece);
+
+            control.nodes++;
+            if (control.should_stop()) {
+                depth = -1;
+                break;
+            }
+
+            if (depth + 1 == total) {
+                if (!control.reserve_solution()) {
+                    depth = -1;
+                    break;
+                }
+                control.solutions++;
+                if (on_solution) on_solution(collect_solution(count), total_pieces_);
+                if (control.solution_limit_reached()) {
+                    depth = -1;
+                    break;
+                }
+                continue;
+            }
+
+            // Prune when the region around the next cell to cover cannot be tiled
+            int anchor = occupied.first_empty();
+            if (prune_regions_ && region_size_(occupied.w, anchor, region_masks_) % PIECE_CELLS != 0) {
+                continue;
+            }
+
+            depth++;
+            open_frame(frames_[depth], occupied, anchor, available);
+            frames_[depth].opened = control.nodes;
+        }
+
+        occupied_ = occupied;
+        remaining_ = remaining;
+        available_ = available;
+        depth_ = depth;
+    }
+
+    // True once a begun search has run out of nodes or was stopped
+    bool finished() const {
+        return depth_ < 0;
+    }
+
+    // Run a begun search only down to leaf_depth placed pieces (counting the
+    // begin_residual() ones) and pass each partial cover that survives region
+    // pruning to on_leaf(pieces, count), in search order; branch() tells the
+    // candidate taken at each level. leaf_depth has to stay below the piece
+    // total and is capped one short of it. The leaves partition the search:
+    // solving each below its pieces visits the full tree, so they can be
+    // shipped off as subtree jobs.
+    template <typename Leaf>
+    void expand(int leaf_depth, SearchControl& control, Leaf&& on_leaf) {
+        const int leaf = std::min(leaf_depth - placed_, total_ - 1);
+        if (depth_ < 0) return;
+        if (leaf <= 0) {
+            on_leaf(static_cast<const PlacedPiece*>(solution_), placed_);
+            depth_ = -1;
+            return;
+        }
+        Bitboard<Words> occupied = occupied_;
+        std::array<int, PIECE_TYPES> remaining = remaining_;
+        uint32_t available = available_;
+        int depth = depth_;
+
+        while (depth >= 0) {
+            Frame& frame = frames_[depth];
+            if (frame.next > 0) {
+                int previous = frame.cand[frame.next - 1];
+                toggle(occupied, previous);
+                int piece = piece_[previous];
+                remaining[piece]++;
+                available |= 1u << piece;
+            }
+            if (frame.next == frame.count) {
+                depth--;
+                continue;
+            }
+
+            int id = frame.cand[frame.next++];
+            toggle(occupied, id);
+            int piece = piece_[id];
+            if (--remaining[piece] == 0) available &= ~(1u << piece);
+
+            control.nodes++;
+            if (control.should_stop()) break;
+
+            int anchor = occupied.first_empty();
+            if (prune_regions_ && region_size_(occupied.w, anchor, region_masks_) % PIECE_CELLS != 0) {
+                continue;
+            }
+            if (depth + 1 == leaf) {
+                on_leaf(collect_levels(placed_, leaf), placed_ + leaf);
+                continue;
+            }
+            depth++;
+            open_frame(frames_[depth], occupied, anchor, available);
+        }
+        depth_ = -1;
+    }
+
+    // Candidate index taken at a search level (0 = first below the prefix)
+    int branch(int level) const {
+        return frames_[level].next - 1;
+    }
+
+    // Levels below the prefix, so a solution's path has this many branches
+    int levels() const {
+        return total_;
+    }
+
+    // Shallowest level of a paused search that still has untried
+    // alternatives, with how many were taken there (the current one
+    // included) and how many are left; false when there are none
+    bool untried_level(int& level, int& tried, int& untried) const {
+        for (int d = 0; d <= depth_; d++) {
+            const Frame& frame = frames_[d];
+            if (frame.next < frame.count) {
+                level = d;
+                tried = frame.next;
+                untried = frame.count - frame.next;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Nodes counted before the search reached `level`, so what it has
+    // searched below that level is the node count now minus this
+    long long opened_at(int level) const {
+        return frames_[level].opened;
+    }
+
+    // Take the last `take` untried alternatives at `level` out of a paused
+    // search. Each goes to on_job(pieces, count, index): the pieces placed
+    // above it plus the alternative, whose candidate index at that level is
+    // `index`, so the caller can search it elsewhere like an expand() leaf.
+    template <typename Job>
+    void donate(int level, int take, Job&& on_job) {
+        Frame& frame = frames_[level];
+        const int count = placed_ + level + 1;
+        collect_levels(placed_, level);
+        for (int i = frame.count - take; i < frame.count; i++) {
+            int id = frame.cand[i];
+            solution_[count - 1].piece = piece_[id];
+            for (int c = 0; c < PIECE_CELLS; c++) solution_[count - 1].cells[c] = cells_[id][c];
+            on_job(static_cast<const PlacedPiece*>(solution_), count, i);
+        }
+        frame.count -= take;
+    }
+
+private:
+    struct Frame {
+        long long opened;             // node count when the search reached it
+        int count;
+        int next;
+        uint16_t cand[MAX_CANDIDATES];
+    };
+
+    int width_ = 0;
+    int height_ = 0;
+    bool transposed_ = false;
+    int total_pieces_ = 0;
+    std::array<int, PIECE_TYPES> counts_{};
+    Bitboard<Words> initial_;
+    RegionMasks<Words> region_masks_;
+    bool prune_regions_ = false;
+    FilterKernel<SPAN> filter_ = nullptr;
+    RegionKernel<Words> region_size_ = nullptr;
+
+    // Placements sorted by anchor (lowest covered bit), all arena-backed
+    int placements_ = 0;
+    uint8_t* piece_ = nullptr;
+    uint16_t* word_ = nullptr;                // first board word of each placement's window
+    uint64_t* test_masks_ = nullptr;          // SPAN words per placement, word-major per anchor block
+    uint64_t* place_masks_ = nullptr;         // SPAN words per placement, placement-major
+    std::array<int, PIECE_CELLS>* cells_ = nullptr;  // covered cells as y * width + x
+    int* anchor_begin_ = nullptr;             // anchor a owns [anchor_begin_[a], anchor_begin_[a + 1])
+    Frame* frames_ = nullptr;
+    PlacedPiece* solution_ = nullptr;
+
+    // Search state between begin_residual() and the end of the search
+    Bitboard<Words> occupied_;
+    std::array<int, PIECE_TYPES> remaining_{};
+    uint32_t available_ = 0;
+    int depth_ = -1;
+    int placed_ = 0;                          // pieces given to begin_residual()
+    int total_ = 0;                           // pieces the search places
+
+    // Enumerate every placement on the open cells, in piece/orientation/position
+    // order. visit(anchor, piece, word, bits, cells) returns false to abort.
+    template <typename Visit>
+    bool for_each_placement(bool transposed, const uint8_t* open,
+                            const OrientationTable& orientations, Visit&& visit) const {
+        const int bits = width_ * height_;
+        for (int piece = 0; piece < PIECE_TYPES; piece++) {
+            if (counts_[piece] == 0) continue;
+            for (const auto& orientation : orientations[piece]) {
+                for (int y = 0; y < height_; y++) {
+                    for (int x = 0; x < width_; x++) {
+                        int low = bits;
+                        int high = -1;
+                        int bit_list[PIECE_CELLS];
+                        std::array<int, PIECE_CELLS> cells;
+                        bool fits = true;
+                        for (int i = 0; i < PIECE_CELLS; i++) {
+                            int cx = x + orientation[i].first;
+                            int cy = y + orientation[i].second;
+                            if (cx >= width_ || cy >= height_ || !open[cy * width_ + cx]) {
+                                fits = false;
+                                break;
+                            }
+                            bit_list[i] = transposed ? cx * height_ + cy : cy * width_ + cx;
+                            cells[i] = cy * width_ + cx;
+                            low = std::min(low, bit_list[i]);
+                            high = std::max(high, bit_list[i]);
+                        }
+                        if (!fits) continue;
+
+                        int word = std::min(low >> 6, Words - SPAN);
+                        if (high >= (word + SPAN) * 64) return false;
+                        if (!visit(low, piece, word, bit_list, cells)) return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // Two passes over the placements: count per anchor, then write each one
+    // straight into its anchor block (a counting sort, stable like the search
+    // order expects), so no intermediate list is needed.
+    bool build_tables(bool transposed, const uint8_t* open,
+                      const OrientationTable& orientations, Arena& arena) {
+        const int bits = width_ * height_;
+        auto bit_of = [&](int x, int y) {
+            return transposed ? x * height_ + y : y * width_ + x;
+        };
+
+        transposed_ = transposed;
+        initial_.fill(~0ULL);
+        for (int y = 0; y < height_; y++) {
+            for (int x = 0; x < width_; x++) {
+                if (open[y * width_ + x]) initial_.reset(bit_of(x, y));
+            }
+        }
+
+        // Row masks for the region flood fill; shifts need a row shorter than a word
+        const int stride = transposed ? height_ : width_;
+        prune_regions_ = stride < 64;
+        region_masks_.stride = prune_regions_ ? stride : 1;
+        for (int i = 0; i < Words; i++) {
+            region_masks_.not_first_col[i] = 0;
+            region_masks_.not_last_col[i] = 0;
+        }
+        for (int bit = 0; bit < bits; bit++) {
+            if (bit % stride != 0) region_masks_.not_first_col[bit >> 6] |= 1ULL << (bit & 63);
+            if (bit % stride != stride - 1) region_masks_.not_last_col[bit >> 6] |= 1ULL << (bit & 63);
+        }
+
+        anchor_begin_ = arena.allocate_filled<int>(bits + 1, 0);
+        bool counted = for_each_placement(transposed, open, orientations,
+            [&](int anchor, int, int, const int*, const std::array<int, PIECE_CELLS>&) {
+                anchor_begin_[anchor + 1]++;
+                return true;
+            });
+        if (!counted) return false;
+        for (int a = 0; a < bits; a++) {
+            if (anchor_begin_[a + 1] > MAX_CANDIDATES) return false;
+            anchor_begin_[a + 1] += anchor_begin_[a];
+        }
+
+        const int n = anchor_begin_[bits];
+        placements_ = n;
+        piece_ = arena.allocate<uint8_t>(n);
+        word_ = arena.allocate<uint16_t>(n);
+        cells_ = arena.allocate<std::array<int, PIECE_CELLS>>(n);
+        test_masks_ = arena.allocate_filled<uint64_t>(static_cast<size_t>(n) * SPAN, 0);
+        place_masks_ = arena.allocate_filled<uint64_t>(static_cast<size_t>(n) * SPAN, 0);
+
+        int* filled = arena.allocate_filled<int>(bits, 0);
+        return for_each_placement(transposed, open, orientations,
+            [&](int anchor, int piece, int word, const int* bit_list,
+                const std::array<int, PIECE_CELLS>& cells) {
+                int begin = anchor_begin_[anchor];
+                int block = anchor_begin_[anchor + 1] - begin;
+                int i = filled[anchor]++;
+                piece_[begin + i] = static_cast<uint8_t>(piece);
+                word_[begin + i] = static_cast<uint16_t>(word);
+                cells_[begin + i] = cells;
+                for (int c = 0; c < PIECE_CELLS; c++) {
+                    int rel = bit_list[c] - word * 64;
+                    uint64_t bit = 1ULL << (rel & 63);
+                    test_masks_[static_cast<size_t>(begin) * SPAN + (rel >> 6) * block + i] |= bit;
+                    place_masks_[static_cast<size_t>(begin + i) * SPAN + (rel >> 6)] |= bit;
+                }
+                return true;
+            });
+    }
+
+    void open_frame(Frame& frame, const Bitboard<Words>& occupied, int anchor, uint32_t available) {
+        frame.next = 0;
+        int begin = anchor_begin_[anchor];
+        int block = anchor_begin_[anchor + 1] - begin;
+        if (block == 0) {
+            frame.count = 0;
+            return;
+        }
+        frame.count = filter_(
+            &test_masks_[static_cast<size_t>(begin) * SPAN], &piece_[begin], block,
+            &occupied.w[word_[begin]], available, begin, frame.cand);
+    }
+
+    // Placements are their own inverse under XOR
+    void toggle(Bitboard<Words>& occupied, int id) const {
+        const uint64_t* mask = &place_masks_[static_cast<size_t>(id) * SPAN];
+        uint64_t* target = &occupied.w[word_[id]];
+        for (int k = 0; k < SPAN; k++) target[k] ^= mask[k];
+    }
+
+    int bit_of_cell(int cell) const {
+        return transposed_ ? (cell % width_) * height_ + cell / width_ : cell;
+    }
+
+    // Pieces placed by the search follow the `placed` ones already in solution_
+    const PlacedPiece* collect_solution(int placed) {
+        return collect_levels(placed, total_pieces_ - placed);
+    }
+
+    const PlacedPiece* collect_levels(int placed, int levels) {
+        for (int d = 0; d < levels; d++) {
+            int id = frames_[d].cand[frames_[d].next - 1];
+            solution_[placed + d].piece = piece_[id];
+            for (int i = 0; i < PIECE_CELLS; i++) solution_[placed + d].cells[i] = cells_[id][i];
+        }
+        return solution_;
+    }
+};
+
+#endif // PENTOMINO_BITBOARD_H
@@ -27,7 +27,7 @@ mkdir -p ../public/wasm
 # Compile C++ to WebAssembly
 echo "🚀 Compiling C++ to WebAssembly..."
 
-emcc pentomino_solver.cpp \
+emcc pentomino_solver.cpp pentomino_capi.cpp \
     -o ../public/wasm/pentomino_solver.js \
     -s WASM=1 \
     -s EXPORTED_RUNTIME_METHODS='["ccall", "cwrap"]' \
@@ -47,13 +47,74 @@ emcc pentomino_solver.cpp \
     -s STACK_OVERFLOW_CHECK=0 \
     -s DEMANGLE_SUPPORT=0
 
+# SIMD128 variant, picked by the loader when the browser supports wasm SIMD
+echo "🚀 Compiling SIMD128 variant..."
+
+emcc pentomino_solver.cpp pentomino_capi.cpp \
+    -o ../public/wasm/pentomino_solver_simd.js \
+    -s WASM=1 \
+    -s EXPORTED_RUNTIME_METHODS='["ccall", "cwrap"]' \
+    -s ALLOW_MEMORY_GROWTH=1 \
+    -s MODULARIZE=1 \
+    -s EXPORT_NAME="PentominoSolverModule" \
+    -s ENVIRONMENT='web' \
+    -s SINGLE_FILE=0 \
+    -s USE_ES6_IMPORT_META=0 \
+    -s EXPORT_ES6=1 \
+    --bind \
+    -O3 \
+    -flto \
+    -msimd128 \
+    --closure 1 \
+    -s ASSERTIONS=0 \
+    -s SAFE_HEAP=0 \
+    -s STACK_OVERFLOW_CHECK=0 \
+    -s DEMANGLE_SUPPORT=0
+
+# Lean modules: the C ABI exported as is, without embind (see LEAN_FUNCTIONS in the Makefile)
+LEAN_EXPORTS=_malloc,_free,_pentomino_abi_version,_pentomino_create,_pentomino_destroy,_pentomino_last_error
+LEAN_EXPORTS=$LEAN_EXPORTS,_pentomino_set_board,_pentomino_set_piece_counts,_pentomino_set_algorithm,_pentomino_set_limits
+LEAN_EXPORTS=$LEAN_EXPORTS,_pentomino_set_node_limit,_pentomino_set_deterministic,_pentomino_set_solution_capacity,_pentomino_solve,_pentomino_start,_pentomino_step
+LEAN_EXPORTS=$LEAN_EXPORTS,_pentomino_get_result,_pentomino_stop,_pentomino_get_progress,_pentomino_get_board
+LEAN_EXPORTS=$LEAN_EXPORTS,_pentomino_solution_count,_pentomino_get_solution,_pentomino_get_solution_board
+
+for variant in lean lean_simd; do
+    echo "🚀 Compiling $variant module..."
+    SIMD=""
+    if [ "$variant" = "lean_simd" ]; then SIMD="-msimd128"; fi
+    emcc pentomino_capi.cpp \
+        -o ../public/wasm/pentomino_$variant.js \
+        -s WASM=1 \
+        -s WASM_BIGINT=1 \
+        -s EXPORTED_FUNCTIONS="$LEAN_EXPORTS" \
+        -s EXPORTED_RUNTIME_METHODS='["HEAPU8", "UTF8ToString", "stringToUTF8", "lengthBytesUTF8"]' \
+        -s ALLOW_MEMORY_GROWTH=1 \
+        -s MODULARIZE=1 \
+        -s EXPORT_NAME="PentominoSolverModule" \
+        -s ENVIRONMENT='web' \
+        -s SINGLE_FILE=0 \
+        -s USE_ES6_IMPORT_META=0 \
+        -s EXPORT_ES6=1 \
+        -O3 \
+        -flto \
+        $SIMD \
+        --closure 1 \
+        -s ASSERTIONS=0 \
+        -s SAFE_HEAP=0 \
+        -s STACK_OVERFLOW_CHECK=0 \
+        -s DEMANGLE_SUPPORT=0
+done
+
 echo "✅ WebAssembly compilation complete!"
 
 # Check output files
-if [ -f "../public/wasm/pentomino_solver.js" ] && [ -f "../public/wasm/pentomino_solver.wasm" ]; then
+if [ -f "../public/wasm/pentomino_solver.js" ] && [ -f "../public/wasm/pentomino_solver.wasm" ] && [ -f "../public/wasm/pentomino_solver_simd.wasm" ] && [ -f "../public/wasm/pentomino_lean_simd.wasm" ]; then
     echo "📦 Generated files:"
     echo "   - pentomino_solver.js ($(du -h ../public/wasm/pentomino_solver.js | cut -f1))"
     echo "   - pentomino_solver.wasm ($(du -h ../public/wasm/pentomino_solver.wasm | cut -f1))"
+    echo "   - pentomino_solver_simd.wasm ($(du -h ../public/wasm/pentomino_solver_simd.wasm | cut -f1))"
+    echo "   - pentomino_lean.wasm ($(du -h ../public/wasm/pentomino_lean.wasm | cut -f1))"
+    echo "   - pentomino_lean_simd.wasm ($(du -h ../public/wasm/pentomino_lean_simd.wasm | cut -f1))"
 else
     echo "❌ Error: Expected output files not found!"
     exit 1
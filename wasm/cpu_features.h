@@ -0,0 +1,100 @@
+#ifndef PENTOMINO_CPU_FEATURES_H
+#define PENTOMINO_CPU_FEATURES_H
+
+#include <cstring>
+
+// Native x86 builds carry AVX2/AVX-512 kernels compiled with per-function target
+// attributes and choose between them at runtime, so one binary runs on any host.
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__EMSCRIPTEN__) && defined(__GNUC__)
+#define PENTOMINO_X86_KERNELS 1
+#include <immintrin.h>
+#define PENTOMINO_TARGET_AVX2 __attribute__((target("avx2,bmi,popcnt")))
+#define PENTOMINO_TARGET_AVX512 __attribute__((target("avx512f,avx2,bmi,popcnt")))
+#define PENTOMINO_TARGET_AVX512_POPCNT __attribute__((target("avx512f,avx512vpopcntdq,avx2,bmi,popcnt")))
+#define PENTOMINO_TARGET_AVX512_LANES __attribute__((target("avx512f,avx512cd,avx512vl,avx2,bmi,popcnt")))
+#endif
+
+// Instruction set used by the batch kernels, ordered by preference
+enum class KernelIsa {
+    SCALAR = 0,
+    SIMD128 = 1,
+    AVX2 = 2,
+    AVX512 = 3
+};
+
+inline const char* kernel_isa_name(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::SIMD128: return "simd128";
+        case KernelIsa::AVX2: return "avx2";
+        case KernelIsa::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+inline bool parse_kernel_isa(const char* name, KernelIsa& isa) {
+    const KernelIsa all[] = {KernelIsa::SCALAR, KernelIsa::SIMD128, KernelIsa::AVX2, KernelIsa::AVX512};
+    for (KernelIsa candidate : all) {
+        if (std::strcmp(name, kernel_isa_name(candidate)) == 0) {
+            isa = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Best kernel ISA the host supports
+inline KernelIsa detect_kernel_isa() {
+#if defined(__wasm_simd128__)
+    return KernelIsa::SIMD128;
+#elif defined(PENTOMINO_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")) return KernelIsa::AVX512;
+    if (__builtin_cpu_supports("avx2")) return KernelIsa::AVX2;
+    return KernelIsa::SCALAR;
+#else
+    return KernelIsa::SCALAR;
+#endif
+}
+
+// AVX-512 VPOPCNTDQ is optional on top of AVX-512F
+inline bool host_has_vector_popcount() {
+#if defined(PENTOMINO_X86_KERNELS)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512vpopcntdq");
+#else
+    return false;
+#endif
+}
+
+// Lane kernels also need AVX-512 CD (vplzcntq) and VL (masked 256-bit ops)
+inline bool host_has_avx512_lane_ops() {
+#if defined(PENTOMINO_X86_KERNELS)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512vl");
+#else
+    return false;
+#endif
+}
+
+inline KernelIsa& kernel_isa_setting() {
+    static KernelIsa isa = detect_kernel_isa();
+    return isa;
+}
+
+// ISA the engines dispatch to; engines read it once per setup
+inline KernelIsa active_kernel_isa() {
+    return kernel_isa_setting();
+}
+
+// Restrict the kernels to a lower ISA, e.g. to compare kernels in benchmarks.
+// Returns false (and changes nothing) if the host cannot run the requested ISA.
+inline bool set_kernel_isa(KernelIsa isa) {
+    KernelIsa best = detect_kernel_isa();
+    bool supported = isa == KernelIsa::SCALAR || isa == best ||
+                     (isa == KernelIsa::AVX2 && best == KernelIsa::AVX512);
+    if (!supported) return false;
+    kernel_isa_setting() = isa;
+    return true;
+}
+
+#endif // PENTOMINO_CPU_FEATURES_H
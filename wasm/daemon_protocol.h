@@ -0,0 +1,382 @@
+#ifndef PENTOMINO_DAEMON_PROTOCOL_H
+#define PENTOMINO_DAEMON_PROTOCOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <cerrno>
+#include "solver_common.h"
+#include "pentomino_solver.h"
+
+// Binary protocol of pentomino_daemon (POSIX only, not part of the WASM build).
+//
+// A stream carries frames: a u32 payload length, then the payload. All
+// integers are little-endian. Every payload starts with a u8 message type and
+// the u32 request id the client chose; ids only need to be unique per
+// connection.
+//
+//   SOLVE     client -> daemon  u16 width, u16 height, u8 algorithm, u8 flags,
+//                               u32 max_solutions, u32 max_time_ms,
+//                               u8 has_counts [, 12 x u8 piece counts],
+//                               ceil(width * height / 8) bytes blocked-cell mask
+//                               (bit y * width + x, LSB first)
+//   CANCEL    client -> daemon  (nothing else)
+//   SOLUTION  daemon -> client  u32 index, u16 pieces, pieces x (u8 type, 5 x u16 cell)
+//   RESULT    daemon -> client  u8 status, u32 solutions, u64 nodes, u32 ms,
+//                               u8 timed_out, str engine, str error,
+//                               width * height x i16 first solution board
+//                               (-1 empty, -2 blocked, else piece id)
+//
+// Strings are a u16 length and the bytes. SOLUTION frames are only sent for
+// requests with FLAG_STREAM; every request ends with exactly one RESULT.
+// Requests are interactive unless they set FLAG_BATCH.
+//
+// pentomino_coordinator speaks the same framing to its workers. It sends one
+// SOLVE (id 0) describing the board, then subtree jobs, id = job index:
+//
+//   JOB       coordinator -> worker  u16 levels, levels x u8 branch,
+//                                    u16 pieces, pieces x (u8 type, 5 x u16 cell)
+//   JOB_DONE  worker -> coordinator  u32 solutions, u64 nodes
+//   STEAL     coordinator -> worker  (nothing else; id = the job to split)
+//   DONATION  worker -> coordinator  u64 estimated nodes per job, u16 jobs,
+//                                    jobs x (JOB body)
+//
+// A job's branches are the candidate indices the search took to reach it,
+// so jobs sort into search order by comparing them. The worker answers with
+// SOLUTION frames (index counting within the job) if the SOLVE asked to
+// stream, then JOB_DONE. With FLAG_ORDERED as well, each SOLUTION ends in
+// the solution's own branches from the top of the search, as u16 levels,
+// levels x u8 branch, so solutions of split jobs sort the same way. Between
+// slices of a job it answers every STEAL with one DONATION, possibly empty,
+// of subtrees split off its search, and stops the job early on CANCEL.
+enum class MessageType : uint8_t {
+    SOLVE = 1,
+    CANCEL = 2,
+    SOLUTION = 3,
+    RESULT = 4,
+    JOB = 5,
+    JOB_DONE = 6,
+    STEAL = 7,
+    DONATION = 8,
+};
+
+enum class ReplyStatus : uint8_t {
+    OK = 0,
+    ERROR = 1,
+    CANCELLED = 2,
+};
+
+constexpr uint8_t FLAG_STREAM = 1;        // send every solution as it is found
+constexpr uint8_t FLAG_BATCH = 2;         // batch class: runs in preemptible slices
+constexpr uint8_t FLAG_ORDERED = 4;       // coordinator workers: solutions carry their path
+constexpr uint32_t MAX_FRAME_BYTES = 1 << 20;
+
+struct SolveRequest {
+    uint32_t id = 0;
+    int width = 0;
+    int height = 0;
+    SolverAlgorithm algorithm = SolverAlgorithm::BACKTRACKING;
+    uint8_t flags = 0;
+    int max_solutions = 1;
+    int max_time_ms = 30000;
+    std::vector<int> piece_counts;        // empty = whole sets
+    std::vector<uint8_t> blocked;         // width * height cells, 1 = blocked
+};
+
+struct SolveReply {
+    uint32_t id = 0;
+    ReplyStatus status = ReplyStatus::OK;
+    int solutions = 0;
+    long long nodes = 0;
+    int ms = 0;
+    bool timed_out = false;
+    std::string engine;
+    std::string error;
+    std::vector<int16_t> board;           // width * height
+};
+
+class MessageWriter {
+public:
+    explicit MessageWriter(MessageType type, uint32_t id) {
+        u8(static_cast<uint8_t>(type));
+        u32(id);
+    }
+
+    void u8(uint8_t v) { bytes_.push_back(v); }
+    void u16(uint16_t v) { put(v, 2); }
+    void u32(uint32_t v) { put(v, 4); }
+    void u64(uint64_t v) { put(v, 8); }
+    void str(const std::string& s) {
+        u16(static_cast<uint16_t>(s.size()));
+        bytes_.insert(bytes_.end(), s.begin(), s.end());
+    }
+    void raw(const uint8_t* data, size_t size) { bytes_.insert(bytes_.end(), data, data + size); }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+
+    void put(uint64_t v, int size) {
+        for (int i = 0; i < size; i++) bytes_.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+};
+
+// Reads a payload; any read past the end clears ok() and returns zeros
+class MessageReader {
+public:
+    MessageReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    bool ok() const { return ok_; }
+    bool at_end() const { return pos_ == size_; }
+
+    uint8_t u8() { return static_cast<uint8_t>(get(1)); }
+    uint16_t u16() { return static_cast<uint16_t>(get(2)); }
+    uint32_t u32() { return static_cast<uint32_t>(get(4)); }
+    uint64_t u64() { return get(8); }
+    std::string str() {
+        size_t size = u16();
+        if (!take(size)) return std::string();
+        return std::string(reinterpret_cast<const char*>(data_ + pos_ - size), size);
+    }
+    const uint8_t* raw(size_t size) { return take(size) ? data_ + pos_ - size : nullptr; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+
+    bool take(size_t size) {
+        if (!ok_ || size_ - pos_ < size) {
+            ok_ = false;
+            return false;
+        }
+        pos_ += size;
+        return true;
+    }
+
+    uint64_t get(int size) {
+        if (!take(size)) return 0;
+        uint64_t v = 0;
+        for (int i = 0; i < size; i++) v |= static_cast<uint64_t>(data_[pos_ - size + i]) << (8 * i);
+        return v;
+    }
+};
+
+inline std::vector<uint8_t> encode_solve(const SolveRequest& request) {
+    MessageWriter out(MessageType::SOLVE, request.id);
+    out.u16(static_cast<uint16_t>(request.width));
+    out.u16(static_cast<uint16_t>(request.height));
+    out.u8(static_cast<uint8_t>(request.algorithm));
+    out.u8(request.flags);
+    out.u32(static_cast<uint32_t>(request.max_solutions));
+    out.u32(static_cast<uint32_t>(request.max_time_ms));
+    out.u8(request.piece_counts.empty() ? 0 : 1);
+    if (!request.piece_counts.empty()) {
+        for (int p = 0; p < PIECE_TYPES; p++) {
+            out.u8(static_cast<uint8_t>(p < static_cast<int>(request.piece_counts.size()) ? request.piece_counts[p] : 0));
+        }
+    }
+    std::vector<uint8_t> mask((request.width * request.height + 7) / 8, 0);
+    for (int i = 0; i < request.width * request.height; i++) {
+        if (request.blocked[i]) mask[i >> 3] |= 1 << (i & 7);
+    }
+    out.raw(mask.data(), mask.size());
+    return out.bytes();
+}
+
+inline bool decode_solve(MessageReader& in, SolveRequest& request) {
+    request.width = in.u16();
+    request.height = in.u16();
+    uint8_t algorithm = in.u8();
+    request.algorithm = static_cast<SolverAlgorithm>(algorithm);
+    request.flags = in.u8();
+    request.max_solutions = static_cast<int>(in.u32());
+    request.max_time_ms = static_cast<int>(in.u32());
+    request.piece_counts.clear();
+    if (in.u8()) {
+        for (int p = 0; p < PIECE_TYPES; p++) request.piece_counts.push_back(in.u8());
+    }
+    const int cells = request.width * request.height;
+    const uint8_t* mask = in.raw((cells + 7) / 8);
+    if (!mask || !in.at_end() || algorithm > static_cast<uint8_t>(SolverAlgorithm::HYBRID)) return false;
+    request.blocked.assign(cells, 0);
+    for (int i = 0; i < cells; i++) request.blocked[i] = (mask[i >> 3] >> (i & 7)) & 1;
+    return true;
+}
+
+inline void write_pieces(MessageWriter& out, const PlacedPiece* pieces, int count) {
+    out.u16(static_cast<uint16_t>(count));
+    for (int i = 0; i < count; i++) {
+        out.u8(static_cast<uint8_t>(pieces[i].piece));
+        for (int cell : pieces[i].cells) out.u16(static_cast<uint16_t>(cell));
+    }
+}
+
+inline std::vector<uint8_t> encode_solution(uint32_t id, uint32_t index, const PlacedPiece* pieces, int count,
+                                            const uint8_t* path = nullptr, int levels = 0) {
+    MessageWriter out(MessageType::SOLUTION, id);
+    out.u32(index);
+    write_pieces(out, pieces, count);
+    if (path) {
+        out.u16(static_cast<uint16_t>(levels));
+        out.raw(path, levels);
+    }
+    return out.bytes();
+}
+
+// path, when given, receives the branches of an ordered SOLUTION (empty
+// when the frame has none)
+inline bool decode_solution(MessageReader& in, uint32_t& index, std::vector<PlacedPiece>& pieces,
+                            std::vector<uint8_t>* path = nullptr) {
+    index = in.u32();
+    pieces.resize(in.u16());
+    for (PlacedPiece& placed : pieces) {
+        placed.piece = in.u8();
+        for (int& cell : placed.cells) cell = in.u16();
+    }
+    if (path) {
+        path->clear();
+        if (in.ok() && !in.at_end()) {
+            path->resize(in.u16());
+            for (uint8_t& branch : *path) branch = in.u8();
+        }
+    }
+    return in.ok() && in.at_end();
+}
+
+// Subtree job of the coordinator: the search below pieces, reached by path
+struct SubtreeJob {
+    uint32_t index = 0;
+    std::vector<uint8_t> path;
+    std::vector<PlacedPiece> pieces;
+};
+
+inline void write_job(MessageWriter& out, const SubtreeJob& job) {
+    out.u16(static_cast<uint16_t>(job.path.size()));
+    out.raw(job.path.data(), job.path.size());
+    write_pieces(out, job.pieces.data(), static_cast<int>(job.pieces.size()));
+}
+
+inline std::vector<uint8_t> encode_job(const SubtreeJob& job) {
+    MessageWriter out(MessageType::JOB, job.index);
+    write_job(out, job);
+    return out.bytes();
+}
+
+// Rejects pieces that do not fit a board of the given cell count
+inline bool read_job(MessageReader& in, int cells, SubtreeJob& job) {
+    size_t levels = in.u16();
+    const uint8_t* path = in.raw(levels);
+    if (!path) return false;
+    job.path.assign(path, path + levels);
+    job.pieces.resize(in.u16());
+    for (PlacedPiece& placed : job.pieces) {
+        placed.piece = in.u8();
+        for (int& cell : placed.cells) cell = in.u16();
+        if (placed.piece >= PIECE_TYPES) return false;
+        for (int cell : placed.cells) {
+            if (cell >= cells) return false;
+        }
+    }
+    return in.ok();
+}
+
+inline bool decode_job(MessageReader& in, int cells, SubtreeJob& job) {
+    return read_job(in, cells, job) && in.at_end();
+}
+
+inline std::vector<uint8_t> encode_donation(uint32_t index, uint64_t estimate, const std::vector<SubtreeJob>& jobs) {
+    MessageWriter out(MessageType::DONATION, index);
+    out.u64(estimate);
+    out.u16(static_cast<uint16_t>(jobs.size()));
+    for (const SubtreeJob& job : jobs) write_job(out, job);
+    return out.bytes();
+}
+
+inline bool decode_donation(MessageReader& in, int cells, uint64_t& estimate, std::vector<SubtreeJob>& jobs) {
+    estimate = in.u64();
+    jobs.resize(in.u16());
+    for (SubtreeJob& job : jobs) {
+        if (!read_job(in, cells, job)) return false;
+    }
+    return in.ok() && in.at_end();
+}
+
+inline std::vector<uint8_t> encode_job_done(uint32_t index, uint32_t solutions, uint64_t nodes) {
+    MessageWriter out(MessageType::JOB_DONE, index);
+    out.u32(solutions);
+    out.u64(nodes);
+    return out.bytes();
+}
+
+inline std::vector<uint8_t> encode_reply(const SolveReply& reply) {
+    MessageWriter out(MessageType::RESULT, reply.id);
+    out.u8(static_cast<uint8_t>(reply.status));
+    out.u32(static_cast<uint32_t>(reply.solutions));
+    out.u64(static_cast<uint64_t>(reply.nodes));
+    out.u32(static_cast<uint32_t>(reply.ms));
+    out.u8(reply.timed_out ? 1 : 0);
+    out.str(reply.engine);
+    out.str(reply.error);
+    for (int16_t cell : reply.board) out.u16(static_cast<uint16_t>(cell));
+    return out.bytes();
+}
+
+// The board is whatever follows the strings, so the decoder needs no size
+inline bool decode_reply(MessageReader& in, SolveReply& reply) {
+    reply.status = static_cast<ReplyStatus>(in.u8());
+    reply.solutions = static_cast<int>(in.u32());
+    reply.nodes = static_cast<long long>(in.u64());
+    reply.ms = static_cast<int>(in.u32());
+    reply.timed_out = in.u8() != 0;
+    reply.engine = in.str();
+    reply.error = in.str();
+    reply.board.clear();
+    while (in.ok() && !in.at_end()) reply.board.push_back(static_cast<int16_t>(in.u16()));
+    return in.ok();
+}
+
+// Blocking frame I/O on a socket or pipe; false on EOF or error
+inline bool write_all(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+inline bool read_all(int fd, uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::read(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+inline bool write_frame(int fd, const std::vector<uint8_t>& payload) {
+    uint8_t header[4];
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    for (int i = 0; i < 4; i++) header[i] = static_cast<uint8_t>(size >> (8 * i));
+    return write_all(fd, header, 4) && write_all(fd, payload.data(), payload.size());
+}
+
+inline bool read_frame(int fd, std::vector<uint8_t>& payload) {
+    uint8_t header[4];
+    if (!read_all(fd, header, 4)) return false;
+    uint32_t size = header[0] | header[1] << 8 | header[2] << 16 | static_cast<uint32_t>(header[3]) << 24;
+    if (size == 0 || size > MAX_FRAME_BYTES) return false;
+    payload.resize(size);
+    return read_all(fd, payload.data(), size);
+}
+
+#endif // PENTOMINO_DAEMON_PROTOCOL_H
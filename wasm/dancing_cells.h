@@ -0,0 +1,240 @@
+#ifndef PENTOMINO_DANCING_CELLS_H
+#define PENTOMINO_DANCING_CELLS_H
+
+#include <array>
+#include <cstdint>
+#include "solver_common.h"
+#include "arena.h"
+#include "pieces.h"
+
+// Exact cover with dancing cells: Knuth's sparse-set successor to dancing links.
+//
+// The active items are a sparse set (a dense array plus each item's position in
+// it), and so is each item's set of options still compatible with the partial
+// solution. Removing an element swaps it with the last one and shortens the
+// set; nothing is unlinked. Because removals are undone in reverse order, undo
+// only has to restore lengths: the removed elements still sit just past the end
+// of their set. A trail records which set lost an element, so backtracking is a
+// run of length increments with no pointer writes.
+//
+// Options are rows of six nodes (piece item, then five cells) stored
+// contiguously; every node knows its item and its current index in that item's
+// set. Like DlxEngine, each piece is used at most once.
+class DancingCellsEngine {
+public:
+    static constexpr int ROW_NODES = PIECE_CELLS + 1;
+
+    static bool supports(const std::array<int, PIECE_TYPES>& counts) {
+        for (int c : counts) {
+            if (c > 1) return false;
+        }
+        return true;
+    }
+
+    // Build the sets for the open cells, allocated from the arena, which must
+    // outlive the engine
+    bool setup(int width, int height, const uint8_t* open,
+               const OrientationTable& orientations,
+               const std::array<int, PIECE_TYPES>& counts, Arena& arena) {
+        if (!supports(counts)) return false;
+
+        // Items: the pieces in use, then the open cells
+        int piece_item[PIECE_TYPES];
+        items_ = 0;
+        for (int p = 0; p < PIECE_TYPES; p++) {
+            piece_item[p] = counts[p] > 0 ? items_++ : -1;
+        }
+        pieces_ = items_;
+        int* cell_item = arena.allocate<int>(width * height);
+        for (int i = 0; i < width * height; i++) {
+            cell_item[i] = open[i] ? items_++ : -1;
+        }
+
+        // First pass: set sizes, so each item's set gets its final slot range
+        set_begin_ = arena.allocate_filled<int32_t>(items_ + 1, 0);
+        options_ = 0;
+        for_each_board_placement(width, height, open, orientations, counts, [&](int piece, const int* cells) {
+            set_begin_[piece_item[piece] + 1]++;
+            for (int i = 0; i < PIECE_CELLS; i++) set_begin_[cell_item[cells[i]] + 1]++;
+            options_++;
+        });
+        for (int k = 0; k < items_; k++) set_begin_[k + 1] += set_begin_[k];
+
+        const int nodes = options_ * ROW_NODES;
+        nodes_ = arena.allocate<Node>(nodes);
+        sets_ = arena.allocate<int32_t>(nodes);
+        set_size_ = arena.allocate_filled<int32_t>(items_, 0);
+        placements_ = arena.allocate<PlacedPiece>(options_);
+
+        int option = 0;
+        for_each_board_placement(width, height, open, orientations, counts, [&](int piece, const int* cells) {
+            placements_[option].piece = piece;
+            for (int t = 0; t < ROW_NODES; t++) {
+                int node = option * ROW_NODES + t;
+                int item = t == 0 ? piece_item[piece] : cell_item[cells[t - 1]];
+                if (t > 0) placements_[option].cells[t - 1] = cells[t - 1];
+                nodes_[node].item = item;
+                nodes_[node].loc = set_size_[item];
+                sets_[set_begin_[item] + set_size_[item]++] = node;
+            }
+            option++;
+        });
+
+        active_ = arena.allocate<int32_t>(items_);
+        item_pos_ = arena.allocate<int32_t>(items_);
+        for (int k = 0; k < items_; k++) active_[k] = item_pos_[k] = k;
+        active_count_ = items_;
+
+        trail_ = arena.allocate<int32_t>(nodes);
+        trail_size_ = 0;
+        levels_ = arena.allocate<Level>(pieces_ + 1);
+        solution_ = arena.allocate<PlacedPiece>(pieces_ + 1);
+        return true;
+    }
+
+    void solve(SearchControl& control, const SolutionCallback& on_solution) {
+        if (pieces_ == 0) return;
+
+        int level = 0;
+        bool descend = true;
+        for (;;) {
+            Level* frame = &levels_[level];
+            if (descend) {
+                if (active_count_ == 0) {
+                    if (!control.reserve_solution()) break;
+                    control.solutions++;
+                    if (on_solution) on_solution(collect_solution(level), level);
+                    if (control.solution_limit_reached()) break;
+                    descend = false;
+                    continue;
+                }
+                // Covering the chosen item leaves its own set untouched, so
+                // the loop below can walk it by index
+                frame->item = choose_item();
+                frame->trail = trail_size_;
+                frame->active = active_count_;
+                cover(frame->item);
+                frame->covered_trail = trail_size_;
+                frame->next = 0;
+            } else {
+                if (--level < 0) break;
+                frame = &levels_[level];
+            }
+
+            // Undo the option tried last at this level, back to just after
+            // covering the item
+            restore(frame->covered_trail, frame->active - 1);
+
+            if (frame->next == set_size_[frame->item]) {
+                restore(frame->trail, frame->active);
+                descend = false;
+                continue;
+            }
+
+            int node = sets_[set_begin_[frame->item] + frame->next++];
+            int base = node - node % ROW_NODES;
+            frame->option = base / ROW_NODES;
+            for (int t = 0; t < ROW_NODES; t++) {
+                if (base + t != node) cover(nodes_[base + t].item);
+            }
+
+            control.nodes++;
+            if (control.should_stop()) break;
+            level++;
+            descend = true;
+        }
+    }
+
+private:
+    // Item and position in that item's set, side by side since hide() needs both
+    struct Node {
+        int32_t item;
+        int32_t loc;
+    };
+
+    struct Level {
+        int item;           // item chosen at this level
+        int next;           // index of the next option to try in its set
+        int option;         // option currently placed
+        int trail;          // trail size before covering the item
+        int covered_trail;  // trail size after covering it
+        int active;         // active item count before covering it
+    };
+
+    int items_ = 0;
+    int pieces_ = 0;
+    int options_ = 0;
+    Node* nodes_ = nullptr;
+    int32_t* sets_ = nullptr;        // all sets back to back, as node indices
+    int32_t* set_begin_ = nullptr;   // items_ + 1 offsets into sets_
+    int32_t* set_size_ = nullptr;    // current length of each set
+    int32_t* active_ = nullptr;      // active items first, active_count_ of them
+    int32_t* item_pos_ = nullptr;    // index of each item in active_
+    int active_count_ = 0;
+    int32_t* trail_ = nullptr;       // items whose set lost its last element
+    int trail_size_ = 0;
+    Level* levels_ = nullptr;
+    PlacedPiece* placements_ = nullptr;  // per option
+    PlacedPiece* solution_ = nullptr;
+
+    // Active item with the fewest remaining options; ties go to the lowest index
+    int choose_item() const {
+        int best = active_[0];
+        int best_size = set_size_[best];
+        for (int a = 1; a < active_count_ && best_size > 0; a++) {
+            int item = active_[a];
+            if (set_size_[item] < best_size || (set_size_[item] == best_size && item < best)) {
+                best = item;
+                best_size = set_size_[item];
+            }
+        }
+        return best;
+    }
+
+    // Deactivate the item and drop every option in its set from the other
+    // items' sets
+    void cover(int item) {
+        int last = active_[--active_count_];
+        int pos = item_pos_[item];
+        active_[pos] = last;
+        item_pos_[last] = pos;
+        active_[active_count_] = item;
+        item_pos_[item] = active_count_;
+
+        const int32_t* set = sets_ + set_begin_[item];
+        for (int s = 0; s < set_size_[item]; s++) {
+            int base = set[s] - set[s] % ROW_NODES;
+            for (int t = 0; t < ROW_NODES; t++) {
+                int node = base + t;
+                int other = nodes_[node].item;
+                if (other != item) hide(node, other);
+            }
+        }
+    }
+
+    // Swap the node to the end of its item's set and shorten the set
+    void hide(int node, int item) {
+        int32_t* set = sets_ + set_begin_[item];
+        int size = --set_size_[item];
+        int loc = nodes_[node].loc;
+        int moved = set[size];
+        set[loc] = moved;
+        nodes_[moved].loc = loc;
+        set[size] = node;
+        nodes_[node].loc = size;
+        trail_[trail_size_++] = item;
+    }
+
+    // Undo hides down to a trail mark and reactivate items down to a count
+    void restore(int trail_mark, int active_count) {
+        while (trail_size_ > trail_mark) set_size_[trail_[--trail_size_]]++;
+        active_count_ = active_count;
+    }
+
+    const PlacedPiece* collect_solution(int depth) {
+        for (int d = 0; d < depth; d++) solution_[d] = placements_[levels_[d].option];
+        return solution_;
+    }
+};
+
+#endif // PENTOMINO_DANCING_CELLS_H
@@ -0,0 +1,229 @@
+#ifndef PENTOMINO_DLX_H
+#define PENTOMINO_DLX_H
+
+#include <array>
+#include <cstdint>
+#include "solver_common.h"
+#include "arena.h"
+#include "pieces.h"
+
+// Algorithm X with dancing links over a structure-of-arrays node store.
+//
+// Every placement is a row of exactly six nodes (its piece column, then its five
+// cells), stored contiguously: row r owns nodes first_node_ + 6 r .. + 5, so
+// walking a row stays inside one or two cache lines and rows need no per-node
+// allocation. Links are int32 indices in separate L, R, U, D and C arrays; the
+// column headers (list links and sizes) sit in their own small array, which the
+// minimum-remaining-values scan at every node reads without touching any node.
+//
+// Each piece is used at most once (a column per piece), so boards needing
+// several copies of a piece are left to the bitboard engine.
+class DlxEngine {
+public:
+    static constexpr int ROW_NODES = PIECE_CELLS + 1;
+
+    static bool supports(const std::array<int, PIECE_TYPES>& counts) {
+        for (int c : counts) {
+            if (c > 1) return false;
+        }
+        return true;
+    }
+
+    // Build the exact cover matrix for the open cells, allocated from the
+    // arena, which must outlive the engine
+    bool setup(int width, int height, const uint8_t* open,
+               const OrientationTable& orientations,
+               const std::array<int, PIECE_TYPES>& counts, Arena& arena) {
+        if (!supports(counts)) return false;
+
+        // Columns: the pieces in use, then the open cells
+        int piece_column[PIECE_TYPES];
+        columns_ = 0;
+        for (int p = 0; p < PIECE_TYPES; p++) {
+            piece_column[p] = counts[p] > 0 ? columns_++ : -1;
+        }
+        pieces_ = columns_;
+        int* cell_column = arena.allocate<int>(width * height);
+        for (int i = 0; i < width * height; i++) {
+            cell_column[i] = open[i] ? columns_++ : -1;
+        }
+
+        // Count rows first so every array is allocated once at its final size
+        rows_ = 0;
+        for_each_board_placement(width, height, open, orientations, counts, [&](int, const int*) { rows_++; });
+
+        root_ = columns_;
+        first_node_ = columns_;
+        const int nodes = first_node_ + rows_ * ROW_NODES;
+        heads_ = arena.allocate<ColumnHead>(columns_ + 1);
+        left_ = arena.allocate<int32_t>(nodes);
+        right_ = arena.allocate<int32_t>(nodes);
+        up_ = arena.allocate<int32_t>(nodes);
+        down_ = arena.allocate<int32_t>(nodes);
+        column_ = arena.allocate<int32_t>(nodes);
+        placements_ = arena.allocate<PlacedPiece>(rows_);
+
+        for (int c = 0; c <= columns_; c++) {
+            heads_[c].left = c == 0 ? columns_ : c - 1;
+            heads_[c].right = c == columns_ ? 0 : c + 1;
+            heads_[c].size = 0;
+        }
+        for (int c = 0; c < columns_; c++) {
+            up_[c] = down_[c] = column_[c] = c;
+        }
+
+        int row = 0;
+        for_each_board_placement(width, height, open, orientations, counts, [&](int piece, const int* cells) {
+            int base = first_node_ + row * ROW_NODES;
+            placements_[row].piece = piece;
+            for (int k = 0; k < ROW_NODES; k++) {
+                int node = base + k;
+                int c = k == 0 ? piece_column[piece] : cell_column[cells[k - 1]];
+                if (k > 0) placements_[row].cells[k - 1] = cells[k - 1];
+                left_[node] = base + (k + ROW_NODES - 1) % ROW_NODES;
+                right_[node] = base + (k + 1) % ROW_NODES;
+                column_[node] = c;
+                up_[node] = up_[c];
+                down_[node] = c;
+                down_[up_[c]] = node;
+                up_[c] = node;
+                heads_[c].size++;
+            }
+            row++;
+        });
+
+        chosen_ = arena.allocate<int32_t>(pieces_ + 1);
+        solution_ = arena.allocate<PlacedPiece>(pieces_ + 1);
+        return true;
+    }
+
+    void solve(SearchControl& control, const SolutionCallback& on_solution) {
+        search(control, on_solution, -1, [](const PlacedPiece*, int) {});
+    }
+
+    // Search only the first leaf_depth levels: each partial cover reaching that
+    // depth goes to on_leaf(placed, leaf_depth) instead of being searched
+    // further. Complete covers found above it still go to on_solution.
+    template <typename Leaf>
+    void solve_prefix(int leaf_depth, SearchControl& control, const SolutionCallback& on_solution,
+                      Leaf&& on_leaf) {
+        search(control, on_solution, leaf_depth, on_leaf);
+    }
+
+private:
+    struct ColumnHead {
+        int32_t left;
+        int32_t right;
+        int32_t size;
+    };
+
+    int columns_ = 0;
+    int pieces_ = 0;
+    int rows_ = 0;
+    int root_ = 0;
+    int first_node_ = 0;
+    ColumnHead* heads_ = nullptr;      // columns_ + 1 entries, root last
+    int32_t* left_ = nullptr;
+    int32_t* right_ = nullptr;
+    int32_t* up_ = nullptr;
+    int32_t* down_ = nullptr;
+    int32_t* column_ = nullptr;
+    PlacedPiece* placements_ = nullptr;  // per row
+    int32_t* chosen_ = nullptr;          // per level: column while opening, then row node
+    PlacedPiece* solution_ = nullptr;
+
+    template <typename Leaf>
+    void search(SearchControl& control, const SolutionCallback& on_solution, int leaf_depth,
+                Leaf&& on_leaf) {
+        if (pieces_ == 0) return;
+
+        int level = 0;
+        bool descend = true;
+        for (;;) {
+            if (descend) {
+                if (heads_[root_].right == root_) {
+                    if (!control.reserve_solution()) break;
+                    control.solutions++;
+                    if (on_solution) on_solution(collect_solution(level), level);
+                    if (control.solution_limit_reached()) break;
+                    descend = false;
+                    continue;
+                }
+                if (level == leaf_depth) {
+                    on_leaf(collect_solution(level), level);
+                    if (control.stopped || control.solution_limit_reached()) break;
+                    descend = false;
+                    continue;
+                }
+                int c = choose_column();
+                cover(c);
+                chosen_[level] = c;    // a column index: the next row tried is down_[c]
+            } else {
+                if (--level < 0) break;
+                int r = chosen_[level];
+                for (int j = left_[r]; j != r; j = left_[j]) uncover(column_[j]);
+            }
+
+            // Next row of the column chosen at this level
+            int r = down_[chosen_[level]];
+            if (r < first_node_) {
+                uncover(r);
+                descend = false;
+                continue;
+            }
+            chosen_[level] = r;
+            for (int j = right_[r]; j != r; j = right_[j]) cover(column_[j]);
+
+            control.nodes++;
+            if (control.should_stop()) break;
+            level++;
+            descend = true;
+        }
+    }
+
+    // Column with the fewest remaining rows; ties go to the first in list order
+    int choose_column() const {
+        int best = heads_[root_].right;
+        int best_size = heads_[best].size;
+        for (int c = heads_[best].right; c != root_ && best_size > 0; c = heads_[c].right) {
+            if (heads_[c].size < best_size) {
+                best = c;
+                best_size = heads_[c].size;
+            }
+        }
+        return best;
+    }
+
+    void cover(int c) {
+        heads_[heads_[c].right].left = heads_[c].left;
+        heads_[heads_[c].left].right = heads_[c].right;
+        for (int i = down_[c]; i != c; i = down_[i]) {
+            for (int j = right_[i]; j != i; j = right_[j]) {
+                up_[down_[j]] = up_[j];
+                down_[up_[j]] = down_[j];
+                heads_[column_[j]].size--;
+            }
+        }
+    }
+
+    void uncover(int c) {
+        for (int i = up_[c]; i != c; i = up_[i]) {
+            for (int j = left_[i]; j != i; j = left_[j]) {
+                heads_[column_[j]].size++;
+                up_[down_[j]] = j;
+                down_[up_[j]] = j;
+            }
+        }
+        heads_[heads_[c].right].left = c;
+        heads_[heads_[c].left].right = c;
+    }
+
+    const PlacedPiece* collect_solution(int depth) {
+        for (int d = 0; d < depth; d++) {
+            solution_[d] = placements_[(chosen_[d] - first_node_) / ROW_NODES];
+        }
+        return solution_;
+    }
+};
+
+#endif // PENTOMINO_DLX_H
@@ -0,0 +1,119 @@
+#ifndef PENTOMINO_FRAME_QUEUE_H
+#define PENTOMINO_FRAME_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "daemon_protocol.h"
+#include "mpmc_queue.h"
+
+// Outgoing frames of one daemon connection (POSIX only, not part of the WASM
+// build). Every service worker streaming to the connection used to take its
+// write lock and issue two write() calls per SOLUTION, so concurrent searches
+// queued up on that lock at every solution. Now producers only claim a slot
+// in a bounded lock-free queue, and one writer thread per connection drains
+// whatever has piled up into a single write().
+
+// The writer side of a connection. push() hands a frame to the queue; when
+// the queue is full the producer waits for the writer, so a client that
+// reads slowly slows down the searches streaming to it instead of growing
+// memory. The writer sleeps only when the queue is empty, and producers
+// take the wake-up lock only while it does.
+class FrameWriter {
+public:
+    // Frames the queue holds before producers wait
+    static constexpr size_t QUEUE_FRAMES = 1024;
+
+    // Most bytes gathered into one write()
+    static constexpr size_t BATCH_BYTES = 64 * 1024;
+
+    explicit FrameWriter(int fd) : fd_(fd), queue_(QUEUE_FRAMES), writer_([this] { drain(); }) {}
+
+    ~FrameWriter() {
+        close();
+    }
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    // Dropped once the connection failed or is closed
+    void push(std::vector<uint8_t> payload) {
+        if (!writable_.load()) return;
+        while (!queue_.try_push(payload)) {
+            if (!writable_.load()) return;
+            std::this_thread::yield();
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_.notify_one();
+        }
+    }
+
+    // Write what is queued, stop the writer and stop accepting frames.
+    // Does not close the fd.
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            closing_ = true;
+            wake_.notify_one();
+        }
+        if (writer_.joinable()) writer_.join();
+        writable_ = false;
+    }
+
+    // Largest number of frames one write() carried so far
+    size_t largest_batch() const {
+        return largest_batch_.load();
+    }
+
+private:
+    int fd_;
+    MpmcQueue<std::vector<uint8_t>> queue_;
+    std::atomic<bool> writable_{true};   // false after a write failed
+    std::atomic<bool> sleeping_{false};  // writer waits on wake_
+    std::atomic<size_t> largest_batch_{0};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool closing_ = false;               // guarded by wake_mutex_
+    std::thread writer_;
+
+    void drain() {
+        std::vector<uint8_t> batch;
+        std::vector<uint8_t> payload;
+        for (;;) {
+            // Gather frames, length prefixes included, up to BATCH_BYTES
+            batch.clear();
+            size_t frames = 0;
+            while (batch.size() < BATCH_BYTES && queue_.try_pop(payload)) {
+                uint32_t size = static_cast<uint32_t>(payload.size());
+                for (int i = 0; i < 4; i++) batch.push_back(static_cast<uint8_t>(size >> (8 * i)));
+                batch.insert(batch.end(), payload.begin(), payload.end());
+                frames++;
+            }
+            if (frames > 0) {
+                if (frames > largest_batch_.load()) largest_batch_ = frames;
+                if (writable_.load() && !write_all(fd_, batch.data(), batch.size())) writable_ = false;
+                continue;
+            }
+
+            // Empty: sleep until a producer pushes. Both sides fence between
+            // their store and their load, so either the writer sees the new
+            // frame here or the producer sees sleeping_ and wakes it.
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (queue_.empty()) {
+                if (closing_) return;
+                wake_.wait(lock);
+            }
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif // PENTOMINO_FRAME_QUEUE_H
@@ -0,0 +1,71 @@
+#ifndef PENTOMINO_HYBRID_ENGINE_H
+#define PENTOMINO_HYBRID_ENGINE_H
+
+#include <array>
+#include <cstdint>
+#include "solver_common.h"
+#include "arena.h"
+#include "bitboard.h"
+#include "dlx.h"
+
+// Split depth for a board: DLX levels before the bitboard search takes over.
+// Fitted to `pentomino_bench --split-sweep` (see README). The bitboard walks the
+// short side, so on boards up to five wide its first empty cell is already a
+// tightly constrained one and DLX levels only add overhead; on wider boards
+// its early branching is wide and two MRV levels cut the time by 25-60%.
+inline int hybrid_split_depth(int width, int height, int open_cells) {
+    int short_side = width < height ? width : height;
+    if (open_cells < 30 || short_side <= 5) return 0;
+    return 2;
+}
+
+// Dancing links for the first split_depth levels, where the minimum-remaining-
+// values choice keeps the tree narrow, then the bitboard engine's first-empty-
+// cell search on what is left, where its low per-node cost wins. Each partial
+// cover at the split depth is handed over as a list of placed pieces; the
+// bitboard marks them occupied and drops them from the piece mask.
+template <int Words>
+class HybridEngine {
+public:
+    static bool supports(const std::array<int, PIECE_TYPES>& counts) {
+        return DlxEngine::supports(counts);
+    }
+
+    // Negative split depths pick hybrid_split_depth() for the board
+    void set_split_depth(int depth) { requested_split_ = depth; }
+    int split_depth() const { return split_depth_; }
+
+    bool setup(int width, int height, const uint8_t* open,
+               const OrientationTable& orientations,
+               const std::array<int, PIECE_TYPES>& counts, Arena& arena) {
+        if (!supports(counts)) return false;
+        Arena::Mark start = arena.mark();
+        if (!leaves_.setup(width, height, open, orientations, counts, arena) ||
+            !top_.setup(width, height, open, orientations, counts, arena)) {
+            arena.rewind(start);
+            return false;
+        }
+        int open_cells = 0;
+        for (int i = 0; i < width * height; i++) open_cells += open[i] ? 1 : 0;
+        split_depth_ = requested_split_ >= 0 ? requested_split_ : hybrid_split_depth(width, height, open_cells);
+        return true;
+    }
+
+    void solve(SearchControl& control, const SolutionCallback& on_solution) {
+        if (split_depth_ == 0) {
+            leaves_.solve(control, on_solution);
+            return;
+        }
+        top_.solve_prefix(split_depth_, control, on_solution, [&](const PlacedPiece* placed, int count) {
+            leaves_.solve_residual(placed, count, control, on_solution);
+        });
+    }
+
+private:
+    DlxEngine top_;
+    BitboardEngine<Words> leaves_;
+    int requested_split_ = -1;
+    int split_depth_ = 0;
+};
+
+#endif // PENTOMINO_HYBRID_ENGINE_H
@@ -0,0 +1,256 @@
+#ifndef PENTOMINO_LANE_ENGINE_H
+#define PENTOMINO_LANE_ENGINE_H
+
+#include <vector>
+#include <array>
+#include <map>
+#include <algorithm>
+#include <cstdint>
+#include "solver_common.h"
+#include "cpu_features.h"
+#include "lane_kernels.h"
+
+// One board of a lane batch: at most 64 cells, every piece used at most once
+struct LaneBoard {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> open;  // width * height, 1 = cell to cover
+    uint32_t pieces = 0;        // bit p: piece p is part of the solution
+    int max_solutions = 0;      // 0 = all
+};
+
+struct LaneResult {
+    int solutions = 0;
+    long long nodes = 0;
+    bool finished = false;      // searched to the end or reached max_solutions
+    std::vector<PlacedPiece> first_solution;
+};
+
+// Throughput engine for many small boards. Independent searches are packed into
+// SIMD lanes (two vectors of eight with AVX-512, of four with AVX2) and
+// stepped in lockstep; when a lane's search ends, the next queued board is
+// loaded into it. Boards sharing a row stride share one placement table built
+// for the tallest such board: cells beyond a board's edge start out occupied,
+// so placements crossing them never fit. Tables are kept across calls.
+//
+// There is no region pruning here: per-board latency is worse than
+// BitboardEngine, but setup is a few stores and the lanes never mispredict.
+class LaneBatchEngine {
+public:
+    static constexpr int BURST_STEPS = 4096;
+    static constexpr int SCALAR_LANES = 8;
+
+    static bool fits(const LaneBoard& board) {
+        return board.width > 0 && board.height > 0 && board.width * board.height <= 64;
+    }
+
+    // Lanes beat board-by-board solving only with eight-wide masked gathers and
+    // scatters; on AVX2 the batch benchmark measures about 0.8x
+    static bool preferred() {
+        return active_kernel_isa() == KernelIsa::AVX512 && host_has_avx512_lane_ops();
+    }
+
+    // Results are indexed like `boards`; boards that do not fit are left untouched
+    std::vector<LaneResult> solve(const std::vector<LaneBoard>& boards,
+                                  const OrientationTable& orientations,
+                                  SearchControl& control) {
+        std::vector<LaneResult> results(boards.size());
+
+        // Group the boards by row stride (the short side)
+        std::map<int, std::vector<int>> groups;
+        for (size_t i = 0; i < boards.size(); i++) {
+            if (fits(boards[i])) groups[stride_of(boards[i])].push_back(static_cast<int>(i));
+        }
+
+        KernelIsa isa = active_kernel_isa();
+        for (const auto& group : groups) {
+            const LaneTable& table = table_for(group.first, orientations);
+#ifdef PENTOMINO_X86_KERNELS
+            if (isa == KernelIsa::AVX512 && host_has_avx512_lane_ops()) {
+                run_group<8 * LANE_GROUPS>(table, boards, group.second, results, control, &lane_steps_avx512);
+            } else if (isa == KernelIsa::AVX2 || isa == KernelIsa::AVX512) {
+                run_group<4 * LANE_GROUPS>(table, boards, group.second, results, control, &lane_steps_avx2);
+            } else {
+                run_group<SCALAR_LANES>(table, boards, group.second, results, control, &lane_steps_scalar<SCALAR_LANES>);
+            }
+#else
+            (void)isa;
+            run_group<SCALAR_LANES>(table, boards, group.second, results, control, &lane_steps_scalar<SCALAR_LANES>);
+#endif
+            if (control.stopped) break;
+        }
+        return results;
+    }
+
+private:
+    std::map<int, LaneTable> tables_;
+
+    static int stride_of(const LaneBoard& board) {
+        return std::min(board.width, board.height);
+    }
+
+    // Short side along the stride, as in BitboardEngine
+    static int bit_of(const LaneBoard& board, int x, int y) {
+        return board.width > board.height ? x * board.height + y : y * board.width + x;
+    }
+
+    static int cell_of(const LaneBoard& board, int bit) {
+        int stride = stride_of(board);
+        int col = bit % stride;
+        int row = bit / stride;
+        return board.width > board.height ? col * board.width + row : row * board.width + col;
+    }
+
+    // All placements of all pieces on a stride x (64 / stride) board. The
+    // orientation set is closed under transposition, so transposed boards use
+    // the same table.
+    const LaneTable& table_for(int stride, const OrientationTable& orientations) {
+        auto found = tables_.find(stride);
+        if (found != tables_.end()) return found->second;
+
+        const int rows = 64 / stride;
+        std::vector<std::pair<int, std::pair<uint64_t, int>>> raw;  // anchor, (mask, piece)
+        for (int piece = 0; piece < PIECE_TYPES; piece++) {
+            for (const auto& orientation : orientations[piece]) {
+                for (int row = 0; row < rows; row++) {
+                    for (int col = 0; col < stride; col++) {
+                        uint64_t mask = 0;
+                        bool inside = true;
+                        for (const auto& cell : orientation) {
+                            int c = col + cell.first;
+                            int r = row + cell.second;
+                            if (c >= stride || r >= rows) {
+                                inside = false;
+                                break;
+                            }
+                            mask |= 1ULL << (r * stride + c);
+                        }
+                        if (inside) raw.push_back({__builtin_ctzll(mask), {mask, piece}});
+                    }
+                }
+            }
+        }
+        std::stable_sort(raw.begin(), raw.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        LaneTable& table = tables_[stride];
+        table.stride = stride;
+        const int n = static_cast<int>(raw.size());
+        for (const auto& placement : raw) table.begin[placement.first + 1]++;
+        for (int a = 0; a < 64; a++) table.begin[a + 1] += table.begin[a];
+        for (int a = 0; a < 64; a++) {
+            table.blocks[a] = static_cast<uint32_t>(table.begin[a]) |
+                              static_cast<uint64_t>(table.begin[a + 1]) << 32;
+        }
+
+        // Pieces are contiguous inside each block (stable sort of piece-major input)
+        table.masks.resize(n + 1);
+        table.info.resize(n + 1);
+        for (int i = n - 1, group_end = n; i >= 0; i--) {
+            if (i + 1 == n || raw[i + 1].first != raw[i].first ||
+                raw[i + 1].second.second != raw[i].second.second) {
+                group_end = i + 1;
+            }
+            table.masks[i] = raw[i].second.first;
+            table.info[i] = raw[i].second.second | (group_end << LaneTable::PIECE_BITS);
+        }
+        table.masks[n] = ~0ULL;
+        table.info[n] = n << LaneTable::PIECE_BITS;
+        return table;
+    }
+
+    template <int Lanes>
+    static void load_lane(LaneState<Lanes>& s, int l, const LaneBoard& board, const LaneTable& table) {
+        uint64_t occupied = ~0ULL;
+        for (int y = 0; y < board.height; y++) {
+            for (int x = 0; x < board.width; x++) {
+                if (board.open[y * board.width + x]) occupied &= ~(1ULL << bit_of(board, x, y));
+            }
+        }
+        int anchor = __builtin_ctzll(~occupied | (1ULL << 63));
+        s.occupied[l] = occupied;
+        s.available[l] = static_cast<int32_t>(board.pieces);
+        s.depth[l] = 0;
+        s.next[l] = table.begin[anchor];
+        s.end[l] = table.begin[anchor + 1];
+        s.target[l] = __builtin_popcount(board.pieces);
+        s.active[l] = -1;
+        s.nodes[l] = 0;
+    }
+
+    template <int Lanes>
+    static void collect_solution(const LaneState<Lanes>& s, int l, const LaneBoard& board,
+                                 const LaneTable& table, std::vector<PlacedPiece>& solution) {
+        solution.resize(s.target[l]);
+        for (int d = 0; d < s.target[l]; d++) {
+            int id = s.stack[d][l] & ((1 << LANE_STACK_SHIFT) - 1);
+            uint64_t mask = table.masks[id];
+            solution[d].piece = table.info[id] & ((1 << LaneTable::PIECE_BITS) - 1);
+            for (int i = 0; i < PIECE_CELLS; i++) {
+                solution[d].cells[i] = cell_of(board, __builtin_ctzll(mask));
+                mask &= mask - 1;
+            }
+        }
+    }
+
+    template <int Lanes>
+    static void run_group(const LaneTable& table, const std::vector<LaneBoard>& boards,
+                          const std::vector<int>& queue, std::vector<LaneResult>& results,
+                          SearchControl& control, LaneKernel<Lanes> kernel) {
+        LaneState<Lanes> s{};
+        int board_of[Lanes];
+        size_t queued = 0;
+        int running = 0;
+
+        // Load the next board with pieces to place, or leave the lane idle
+        auto refill = [&](int l) {
+            while (queued < queue.size()) {
+                int b = queue[queued++];
+                if (boards[b].pieces == 0) {
+                    results[b].finished = true;
+                    continue;
+                }
+                load_lane(s, l, boards[b], table);
+                board_of[l] = b;
+                return true;
+            }
+            s.active[l] = 0;
+            board_of[l] = -1;
+            return false;
+        };
+
+        for (int l = 0; l < Lanes; l++) running += refill(l);
+
+        while (running > 0 && !control.poll()) {
+            uint32_t events = kernel(s, table, BURST_STEPS);
+
+            for (int l = 0; l < Lanes; l++) {
+                if (board_of[l] < 0) continue;
+                results[board_of[l]].nodes += s.nodes[l];
+                control.nodes += s.nodes[l];
+                s.nodes[l] = 0;
+            }
+
+            while (events) {
+                int l = __builtin_ctz(events);
+                events &= events - 1;
+
+                const LaneBoard& board = boards[board_of[l]];
+                LaneResult& result = results[board_of[l]];
+                bool done = s.depth[l] < 0;   // backtracked past the root
+                if (!done) {
+                    result.solutions++;
+                    control.solutions++;
+                    if (result.solutions == 1) collect_solution(s, l, board, table, result.first_solution);
+                    done = board.max_solutions > 0 && result.solutions >= board.max_solutions;
+                }
+                if (done) {
+                    result.finished = true;
+                    if (!refill(l)) running--;
+                }
+            }
+        }
+    }
+};
+
+#endif // PENTOMINO_LANE_ENGINE_H
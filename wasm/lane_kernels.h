@@ -0,0 +1,341 @@
+#ifndef PENTOMINO_LANE_KERNELS_H
+#define PENTOMINO_LANE_KERNELS_H
+
+#include <cstdint>
+#include <vector>
+#include "solver_common.h"
+#include "cpu_features.h"
+
+// Lockstep step kernels for the lane engine. Every lane runs its own
+// first-empty-cell search on a 64-bit board; one step tests one candidate per
+// lane and then, per lane, either places it (descend), records a solution,
+// moves on to the next candidate, or backtracks when its anchor block is
+// exhausted. All four outcomes are computed for every lane and merged with
+// lane masks, so the search itself has no data-dependent branches. A kernel
+// runs up to `budget` steps and returns early with a lane bitmask as soon as a
+// lane finds a solution or exhausts its search.
+
+// Boards of at most 64 cells hold at most 12 pieces
+constexpr int LANE_MAX_DEPTH = 64 / PIECE_CELLS;
+
+// Placements of a board with a given row stride, grouped by anchor (lowest bit)
+// and by piece within an anchor block. info packs the piece (low 4 bits) with
+// the index of the block's next piece group, so a lane whose piece is used up
+// skips the whole group in one step. A trailing all-ones sentinel keeps the
+// candidate load of an exhausted block in bounds; it never fits.
+struct LaneTable {
+    static constexpr int PIECE_BITS = 4;
+
+    int stride = 0;
+    std::vector<uint64_t> masks;
+    std::vector<int32_t> info;
+    int32_t begin[65] = {};   // anchor a owns [begin[a], begin[a + 1])
+    uint64_t blocks[64] = {}; // begin[a] | begin[a + 1] << 32, one load per anchor
+};
+
+// Stack entries hold the placed candidate and the piece set from before it was
+// placed, so backtracking restores both from a single load
+constexpr int LANE_STACK_SHIFT = 16;
+
+template <int Lanes>
+struct LaneState {
+    alignas(64) uint64_t occupied[Lanes];
+    alignas(64) int32_t available[Lanes];  // bit p: piece p still unused
+    alignas(64) int32_t depth[Lanes];      // pieces placed
+    alignas(64) int32_t next[Lanes];       // candidate to test
+    alignas(64) int32_t end[Lanes];        // end of the current anchor block
+    alignas(64) int32_t target[Lanes];     // pieces in a full solution
+    alignas(64) int32_t active[Lanes];     // -1 running, 0 idle
+    alignas(64) int32_t nodes[Lanes];      // placements since the last flush
+    alignas(64) int32_t stack[LANE_MAX_DEPTH][Lanes];  // per depth: candidate | available << 16
+};
+
+// Portable kernel: plain per-lane loops written as selects. Used for scalar and
+// WebAssembly builds, where interleaving the lanes still hides load latency.
+template <int Lanes>
+inline uint32_t lane_steps_scalar(LaneState<Lanes>& s, const LaneTable& table, int budget) {
+    const uint64_t* masks = table.masks.data();
+    const int32_t* info = table.info.data();
+    const int32_t piece_mask = (1 << LaneTable::PIECE_BITS) - 1;
+    uint32_t events = 0;
+
+    for (int step = 0; step < budget && events == 0; step++) {
+        for (int l = 0; l < Lanes; l++) {
+            const bool active = s.active[l] != 0;
+            const int32_t j = s.next[l];
+            const int32_t d = s.depth[l];
+            const uint64_t occupied = s.occupied[l];
+            const int32_t available = s.available[l];
+
+            const bool exhausted = j >= s.end[l];
+            const uint64_t mask = masks[j];
+            const int32_t piece = info[j] & piece_mask;
+            const bool piece_free = ((available >> piece) & 1) != 0;
+            const bool fits = active & !exhausted & ((mask & occupied) == 0) & piece_free;
+            const bool solved = fits & (d + 1 == s.target[l]);
+            const bool descend = fits & !solved;
+            const bool pop = active & exhausted;
+
+            const int32_t slot = d > 0 ? d : 0;
+            s.stack[slot][l] = fits ? j | (available << LANE_STACK_SHIFT) : s.stack[slot][l];
+            const int32_t saved = s.stack[d > 0 ? d - 1 : 0][l];
+            const int32_t parent = saved & ((1 << LANE_STACK_SHIFT) - 1);
+
+            const uint64_t placed = descend ? occupied | mask : occupied;
+            const uint64_t now = pop ? placed ^ masks[parent] : placed;
+            int32_t avail = descend ? available & ~(1 << piece) : available;
+            avail = pop ? saved >> LANE_STACK_SHIFT : avail;
+
+            const uint64_t block = table.blocks[__builtin_ctzll(~now | (1ULL << 63))];
+            int32_t next = (active & !exhausted) ? (piece_free ? j + 1 : info[j] >> LaneTable::PIECE_BITS) : j;
+            next = descend ? static_cast<int32_t>(block) : next;
+            next = pop ? parent + 1 : next;
+
+            s.occupied[l] = now;
+            s.available[l] = avail;
+            s.next[l] = next;
+            s.end[l] = (descend | pop) ? static_cast<int32_t>(block >> 32) : s.end[l];
+            s.depth[l] = d + descend - pop;
+            s.nodes[l] += fits;
+            events |= static_cast<uint32_t>(solved | (pop & (d == 0))) << l;
+        }
+    }
+    return events;
+}
+
+#ifdef PENTOMINO_X86_KERNELS
+// Every step is one long dependency chain (load candidate, test, update board,
+// find the next anchor, load its block), so the vector kernels interleave
+// LANE_GROUPS independent vectors of lanes to keep the gather units busy.
+constexpr int LANE_GROUPS = 2;
+
+// Four lanes per group: boards in 256-bit vectors, per-lane state in 128-bit
+// vectors. AVX2 has no scatter, so the stack slot is merged by gather + blend
+// and written back with one scalar store per lane.
+struct LaneGroupAvx2 {
+    __m256i occupied;
+    __m128i available, depth, next, end, nodes, target, active;
+};
+
+PENTOMINO_TARGET_AVX2
+inline __m128i narrow_mask_avx2(__m256i wide) {
+    const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(wide, low_halves));
+}
+
+template <int Lanes>
+PENTOMINO_TARGET_AVX2
+inline uint32_t lane_step_avx2(LaneGroupAvx2& g, const LaneTable& table, int* stack, int base) {
+    const long long* masks = reinterpret_cast<const long long*>(table.masks.data());
+    const int* info = table.info.data();
+    const __m128i lane = _mm_add_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(base));
+    const __m128i entry_mask = _mm_set1_epi32((1 << LANE_STACK_SHIFT) - 1);
+    const __m128i piece_mask = _mm_set1_epi32((1 << LaneTable::PIECE_BITS) - 1);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m256i zero64 = _mm256_setzero_si256();
+    const __m256i ones64 = _mm256_set1_epi64x(-1);
+    const __m256i top = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+    const __m256i nibble_counts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+
+    const __m128i j = g.next;
+    const __m128i in_block = _mm_cmpgt_epi32(g.end, j);
+    const __m128i live = _mm_and_si128(g.active, in_block);
+    const __m128i pop = _mm_andnot_si128(in_block, g.active);
+
+    const __m256i mask = _mm256_i32gather_epi64(masks, j, 8);
+    const __m128i candidate = _mm_i32gather_epi32(info, j, 4);
+    const __m128i piece = _mm_and_si128(candidate, piece_mask);
+    const __m128i cells_free = narrow_mask_avx2(_mm256_cmpeq_epi64(_mm256_and_si256(mask, g.occupied), zero64));
+    const __m128i piece_free = _mm_cmpeq_epi32(_mm_and_si128(_mm_srlv_epi32(g.available, piece), one), one);
+    const __m128i fits = _mm_and_si128(live, _mm_and_si128(cells_free, piece_free));
+    const __m128i solved = _mm_and_si128(fits, _mm_cmpeq_epi32(_mm_add_epi32(g.depth, one), g.target));
+    const __m128i descend = _mm_andnot_si128(solved, fits);
+
+    // stack[depth][lane] = j for lanes that placed a candidate
+    const __m128i slot = _mm_add_epi32(_mm_mullo_epi32(_mm_max_epi32(g.depth, zero), _mm_set1_epi32(Lanes)), lane);
+    alignas(16) int32_t slots[4];
+    alignas(16) int32_t values[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(slots), slot);
+    _mm_store_si128(reinterpret_cast<__m128i*>(values),
+                    _mm_blendv_epi8(_mm_i32gather_epi32(stack, slot, 4),
+                                    _mm_or_si128(j, _mm_slli_epi32(g.available, LANE_STACK_SHIFT)), fits));
+    for (int l = 0; l < 4; l++) stack[slots[l]] = values[l];
+
+    const __m128i parent_slot = _mm_max_epi32(_mm_sub_epi32(slot, _mm_set1_epi32(Lanes)), lane);
+    const __m128i saved = _mm_i32gather_epi32(stack, parent_slot, 4);
+    const __m128i parent = _mm_and_si128(saved, entry_mask);
+    const __m256i parent_mask = _mm256_i32gather_epi64(masks, parent, 8);
+
+    g.occupied = _mm256_or_si256(g.occupied, _mm256_and_si256(mask, _mm256_cvtepi32_epi64(descend)));
+    g.occupied = _mm256_xor_si256(g.occupied, _mm256_and_si256(parent_mask, _mm256_cvtepi32_epi64(pop)));
+    g.available = _mm_andnot_si128(_mm_and_si128(descend, _mm_sllv_epi32(one, piece)), g.available);
+    g.available = _mm_blendv_epi8(g.available, _mm_srli_epi32(saved, LANE_STACK_SHIFT), pop);
+
+    // Anchor = trailing zeros of the free cells, via popcount(lowest bit - 1)
+    const __m256i free_cells = _mm256_or_si256(_mm256_xor_si256(g.occupied, ones64), top);
+    const __m256i below = _mm256_add_epi64(_mm256_and_si256(free_cells, _mm256_sub_epi64(zero64, free_cells)), ones64);
+    const __m256i counts = _mm256_add_epi8(
+        _mm256_shuffle_epi8(nibble_counts, _mm256_and_si256(below, low_nibble)),
+        _mm256_shuffle_epi8(nibble_counts, _mm256_and_si256(_mm256_srli_epi64(below, 4), low_nibble)));
+    const __m128i anchor = narrow_mask_avx2(_mm256_sad_epu8(counts, zero64));
+    const __m256i block = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(table.blocks), anchor, 8);
+    const __m128i block_begin = narrow_mask_avx2(block);
+    const __m128i block_end = narrow_mask_avx2(_mm256_srli_epi64(block, 32));
+
+    __m128i next = _mm_sub_epi32(j, live);
+    next = _mm_blendv_epi8(next, _mm_srli_epi32(candidate, LaneTable::PIECE_BITS), _mm_andnot_si128(piece_free, live));
+    next = _mm_blendv_epi8(next, block_begin, descend);
+    g.next = _mm_blendv_epi8(next, _mm_add_epi32(parent, one), pop);
+    g.end = _mm_blendv_epi8(g.end, block_end, _mm_or_si128(descend, pop));
+
+    const __m128i finished = _mm_and_si128(pop, _mm_cmpeq_epi32(g.depth, zero));
+    g.depth = _mm_add_epi32(_mm_sub_epi32(g.depth, descend), pop);
+    g.nodes = _mm_sub_epi32(g.nodes, fits);
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(solved, finished))));
+}
+
+PENTOMINO_TARGET_AVX2
+inline uint32_t lane_steps_avx2(LaneState<4 * LANE_GROUPS>& s, const LaneTable& table, int budget) {
+    constexpr int Lanes = 4 * LANE_GROUPS;
+    LaneGroupAvx2 groups[LANE_GROUPS];
+    for (int g = 0; g < LANE_GROUPS; g++) {
+        groups[g].occupied = _mm256_load_si256(reinterpret_cast<const __m256i*>(s.occupied + 4 * g));
+        groups[g].available = _mm_load_si128(reinterpret_cast<const __m128i*>(s.available + 4 * g));
+        groups[g].depth = _mm_load_si128(reinterpret_cast<const __m128i*>(s.depth + 4 * g));
+        groups[g].next = _mm_load_si128(reinterpret_cast<const __m128i*>(s.next + 4 * g));
+        groups[g].end = _mm_load_si128(reinterpret_cast<const __m128i*>(s.end + 4 * g));
+        groups[g].nodes = _mm_load_si128(reinterpret_cast<const __m128i*>(s.nodes + 4 * g));
+        groups[g].target = _mm_load_si128(reinterpret_cast<const __m128i*>(s.target + 4 * g));
+        groups[g].active = _mm_load_si128(reinterpret_cast<const __m128i*>(s.active + 4 * g));
+    }
+
+    uint32_t events = 0;
+    for (int step = 0; step < budget && events == 0; step++) {
+        for (int g = 0; g < LANE_GROUPS; g++) {
+            events |= lane_step_avx2<Lanes>(groups[g], table, &s.stack[0][0], 4 * g) << (4 * g);
+        }
+    }
+
+    for (int g = 0; g < LANE_GROUPS; g++) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s.occupied + 4 * g), groups[g].occupied);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s.available + 4 * g), groups[g].available);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s.depth + 4 * g), groups[g].depth);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s.next + 4 * g), groups[g].next);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s.end + 4 * g), groups[g].end);
+        _mm_store_si128(reinterpret_cast<__m128i*>(s.nodes + 4 * g), groups[g].nodes);
+    }
+    return events;
+}
+
+// Eight lanes per group: boards in one 512-bit vector, per-lane state in 256-bit
+// vectors with AVX-512 mask registers, masked gathers, a scatter for the stack
+// and vplzcntq for the anchor.
+struct LaneGroupAvx512 {
+    __m512i occupied;
+    __m256i available, depth, next, end, nodes, target;
+    __mmask8 active;
+};
+
+template <int Lanes>
+PENTOMINO_TARGET_AVX512_LANES
+inline uint32_t lane_step_avx512(LaneGroupAvx512& g, const LaneTable& table, int* stack, int base) {
+    const long long* masks = reinterpret_cast<const long long*>(table.masks.data());
+    const int* info = table.info.data();
+    const __m256i lane = _mm256_add_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(base));
+    const __m256i entry_mask = _mm256_set1_epi32((1 << LANE_STACK_SHIFT) - 1);
+    const __m256i piece_mask = _mm256_set1_epi32((1 << LaneTable::PIECE_BITS) - 1);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m512i zero64 = _mm512_setzero_si512();
+    const __m512i top = _mm512_set1_epi64(static_cast<long long>(1ULL << 63));
+
+    const __m256i j = g.next;
+    const __mmask8 exhausted = _mm256_cmpge_epi32_mask(j, g.end);
+    const __mmask8 live = g.active & ~exhausted;
+    const __mmask8 pop = g.active & exhausted;
+
+    const __m512i mask = _mm512_i32gather_epi64(j, masks, 8);
+    const __m256i candidate = _mm256_i32gather_epi32(info, j, 4);
+    const __m256i piece = _mm256_and_si256(candidate, piece_mask);
+    const __mmask8 piece_free = _mm256_test_epi32_mask(_mm256_srlv_epi32(g.available, piece), one);
+    const __mmask8 fits = _mm512_mask_testn_epi64_mask(live, mask, g.occupied) & piece_free;
+    const __mmask8 solved = fits & _mm256_cmpeq_epi32_mask(_mm256_add_epi32(g.depth, one), g.target);
+    const __mmask8 descend = fits & ~solved;
+
+    const __m256i slot = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_max_epi32(g.depth, zero), _mm256_set1_epi32(Lanes)), lane);
+    _mm256_mask_i32scatter_epi32(stack, fits, slot, _mm256_or_si256(j, _mm256_slli_epi32(g.available, LANE_STACK_SHIFT)), 4);
+    const __m256i parent_slot = _mm256_max_epi32(_mm256_sub_epi32(slot, _mm256_set1_epi32(Lanes)), lane);
+    const __m256i saved = _mm256_mmask_i32gather_epi32(zero, pop, parent_slot, stack, 4);
+    const __m256i parent = _mm256_and_si256(saved, entry_mask);
+    const __m512i parent_mask = _mm512_mask_i32gather_epi64(zero64, pop, parent, masks, 8);
+
+    g.occupied = _mm512_mask_or_epi64(g.occupied, descend, g.occupied, mask);
+    g.occupied = _mm512_mask_xor_epi64(g.occupied, pop, g.occupied, parent_mask);
+    g.available = _mm256_mask_andnot_epi32(g.available, descend, _mm256_sllv_epi32(one, piece), g.available);
+    g.available = _mm256_mask_srli_epi32(g.available, pop, saved, LANE_STACK_SHIFT);
+
+    // Anchor = 63 - lzcnt(lowest free bit)
+    const __mmask8 moved = descend | pop;
+    const __m512i free_cells = _mm512_ternarylogic_epi64(g.occupied, top, top, 0xCF);   // ~occupied | top
+    const __m512i lowest = _mm512_and_si512(free_cells, _mm512_sub_epi64(zero64, free_cells));
+    const __m256i anchor = _mm512_cvtepi64_epi32(_mm512_sub_epi64(_mm512_set1_epi64(63), _mm512_lzcnt_epi64(lowest)));
+    const __m512i block = _mm512_mask_i32gather_epi64(zero64, moved, anchor,
+                                                      reinterpret_cast<const long long*>(table.blocks), 8);
+    const __m256i block_begin = _mm512_cvtepi64_epi32(block);
+    const __m256i block_end = _mm512_cvtepi64_epi32(_mm512_srli_epi64(block, 32));
+
+    __m256i next = _mm256_mask_add_epi32(j, live, j, one);
+    next = _mm256_mask_srli_epi32(next, live & ~piece_free, candidate, LaneTable::PIECE_BITS);
+    next = _mm256_mask_mov_epi32(next, descend, block_begin);
+    g.next = _mm256_mask_add_epi32(next, pop, parent, one);
+    g.end = _mm256_mask_mov_epi32(g.end, moved, block_end);
+
+    const __mmask8 finished = pop & _mm256_cmpeq_epi32_mask(g.depth, zero);
+    g.depth = _mm256_mask_add_epi32(g.depth, descend, g.depth, one);
+    g.depth = _mm256_mask_sub_epi32(g.depth, pop, g.depth, one);
+    g.nodes = _mm256_mask_add_epi32(g.nodes, fits, g.nodes, one);
+    return static_cast<uint32_t>(solved | finished);
+}
+
+PENTOMINO_TARGET_AVX512_LANES
+inline uint32_t lane_steps_avx512(LaneState<8 * LANE_GROUPS>& s, const LaneTable& table, int budget) {
+    constexpr int Lanes = 8 * LANE_GROUPS;
+    LaneGroupAvx512 groups[LANE_GROUPS];
+    for (int g = 0; g < LANE_GROUPS; g++) {
+        groups[g].occupied = _mm512_load_si512(s.occupied + 8 * g);
+        groups[g].available = _mm256_load_si256(reinterpret_cast<const __m256i*>(s.available + 8 * g));
+        groups[g].depth = _mm256_load_si256(reinterpret_cast<const __m256i*>(s.depth + 8 * g));
+        groups[g].next = _mm256_load_si256(reinterpret_cast<const __m256i*>(s.next + 8 * g));
+        groups[g].end = _mm256_load_si256(reinterpret_cast<const __m256i*>(s.end + 8 * g));
+        groups[g].nodes = _mm256_load_si256(reinterpret_cast<const __m256i*>(s.nodes + 8 * g));
+        groups[g].target = _mm256_load_si256(reinterpret_cast<const __m256i*>(s.target + 8 * g));
+        const __m256i active = _mm256_load_si256(reinterpret_cast<const __m256i*>(s.active + 8 * g));
+        groups[g].active = _mm256_test_epi32_mask(active, active);
+    }
+
+    uint32_t events = 0;
+    for (int step = 0; step < budget && events == 0; step++) {
+        for (int g = 0; g < LANE_GROUPS; g++) {
+            events |= lane_step_avx512<Lanes>(groups[g], table, &s.stack[0][0], 8 * g) << (8 * g);
+        }
+    }
+
+    for (int g = 0; g < LANE_GROUPS; g++) {
+        _mm512_store_si512(s.occupied + 8 * g, groups[g].occupied);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s.available + 8 * g), groups[g].available);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s.depth + 8 * g), groups[g].depth);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s.next + 8 * g), groups[g].next);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s.end + 8 * g), groups[g].end);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s.nodes + 8 * g), groups[g].nodes);
+    }
+    return events;
+}
+#endif
+
+template <int Lanes>
+using LaneKernel = uint32_t (*)(LaneState<Lanes>&, const LaneTable&, int);
+
+#endif // PENTOMINO_LANE_KERNELS_H
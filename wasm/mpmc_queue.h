@@ -0,0 +1,94 @@
+#ifndef PENTOMINO_MPMC_QUEUE_H
+#define PENTOMINO_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded multi-producer, multi-consumer queue (Vyukov's array queue). Each
+// slot carries a sequence number saying whether it is free for the producer
+// holding ticket t (sequence == t) or filled for the consumer holding it
+// (sequence == t + 1), so producers only contend on head_ and consumers on
+// tail_, one compare-exchange each, and never on each other.
+template <typename T>
+class MpmcQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpmcQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots_.reset(new Slot[size]);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; i++) slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // False when the queue is full; value is left alone then
+    bool try_push(T& value) {
+        size_t ticket = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[ticket & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(ticket);
+            if (lag == 0) {
+                if (head_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(ticket + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                ticket = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // False when the queue is empty
+    bool try_pop(T& value) {
+        size_t ticket = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[ticket & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(ticket + 1);
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) {
+                    value = std::move(slot.value);
+                    slot.sequence.store(ticket + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                ticket = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Whether the next pop would find nothing. Exact only for a single
+    // consumer, and a push still being written counts as not there yet.
+    bool empty() const {
+        size_t ticket = tail_.load(std::memory_order_acquire);
+        return slots_[ticket & mask_].sequence.load(std::memory_order_acquire) != ticket + 1;
+    }
+
+    size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{0};   // next ticket to push
+    alignas(64) std::atomic<size_t> tail_{0};   // next ticket to pop
+};
+
+#endif // PENTOMINO_MPMC_QUEUE_H
@@ -0,0 +1,237 @@
+#ifndef PENTOMINO_PARALLEL_SOLVER_H
+#define PENTOMINO_PARALLEL_SOLVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pentomino_solver.h"
+#include "mpmc_queue.h"
+
+// Multithreaded search on one board (native only; the WASM build has no
+// threads). The top of the search is expanded into subtree jobs in search
+// order (PentominoSolver::expand_jobs), and worker threads take them one at a
+// time, each on a PentominoSolver of its own, so the bitboard engine runs
+// below every job.
+//
+// max_solutions is global and exact. Every search reserves each solution
+// from one SharedLimit before reporting it, so the threads together report
+// exactly min(max_solutions, solutions on the board): none is counted or
+// passed to the callback past the limit. The thread that takes the last
+// reservation raises the shared stop flag, which every other search reads
+// at its next node, and threads between jobs check it before taking another.
+//
+// With a solution callback the workers do not call it themselves: each
+// copies its reserved solutions into a bounded lock-free queue, and the
+// thread calling solve() drains that queue in batches and makes the calls.
+// No worker waits on another's callback, only on a full queue.
+class ParallelSolver {
+public:
+    // Job levels expanded before the threads start (6x10: 550 jobs). Every
+    // job sets the engine up afresh, about 0.2 ms, so depth 3 (3222 jobs)
+    // already costs more than it balances.
+    static constexpr int DEFAULT_DEPTH = 2;
+
+    // Solutions queued for the collector before workers wait for it
+    static constexpr size_t QUEUE_SOLUTIONS = 1024;
+
+    // Most solutions the collector takes off the queue between callbacks
+    static constexpr size_t BATCH_SOLUTIONS = 64;
+
+    explicit ParallelSolver(int threads, int depth = DEFAULT_DEPTH)
+        : threads(std::max(1, threads)), depth(depth) {}
+
+    void init_board(int w, int h, const std::vector<std::pair<int, int>>& blocked_cells) {
+        width = w;
+        height = h;
+        blocked = blocked_cells;
+    }
+
+    void set_piece_counts(const std::vector<int>& counts) {
+        piece_counts = counts;
+    }
+
+    void set_config(int max_sol, int max_time) {
+        max_solutions = max_sol;
+        max_time_ms = max_time;
+    }
+
+    // Called with every solution reported, on the thread calling solve(), in
+    // no particular order; the pieces are only valid during the call
+    void set_solution_callback(SolutionCallback callback) {
+        on_solution = std::move(callback);
+    }
+
+    SolveResult solve() {
+        auto start_time = std::chrono::steady_clock::now();
+        limit.remaining = max_solutions > 0 ? max_solutions : LLONG_MAX;
+        limit.stop = false;
+        limit.exhausted_at = {};
+        stop_latency_us = -1;
+
+        std::vector<std::vector<PlacedPiece>> jobs;
+        PentominoSolver expander;
+        expander.init_board(width, height, blocked);
+        expander.set_piece_counts(piece_counts);
+        expander.set_config(0, 0);
+        SolveResult top = expander.expand_jobs(depth, [&](const PlacedPiece* pieces, int count, const uint8_t*, int) {
+            jobs.emplace_back(pieces, pieces + count);
+        });
+        if (!top.success) return top;
+
+        std::atomic<size_t> next_job{0};
+        std::atomic<long long> solutions{0};
+        std::atomic<long long> nodes{top.steps_explored};
+        std::atomic<bool> timed_out{false};
+        std::vector<std::chrono::steady_clock::time_point> stopped_at(threads);
+        std::mutex error_mutex;
+        std::string error;                                     // guarded by error_mutex
+
+        // Solutions on their way to the collector, see collect()
+        const bool collect_solutions = static_cast<bool>(on_solution);
+        MpmcQueue<std::vector<PlacedPiece>> queue(collect_solutions ? QUEUE_SOLUTIONS : 2);
+        std::atomic<int> running{threads};
+        std::atomic<bool> collector_sleeping{false};
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+
+        // Wake the collector if it sleeps. Producers fence between their store
+        // and this load, the collector between its store and its checks, so
+        // either it sees the new state or the producer sees it sleeping.
+        auto wake_collector = [&] {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (collector_sleeping.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(wake_mutex);
+                wake.notify_one();
+            }
+        };
+
+        auto work = [&](int thread) {
+            PentominoSolver solver;
+            solver.set_piece_counts(piece_counts);
+            solver.set_cancel_flag(&limit.stop);
+            solver.set_shared_limit(&limit);
+            if (collect_solutions) {
+                // The engine has reserved the solution already, so every one
+                // pushed here is within the limit
+                solver.set_solution_callback([&](const PlacedPiece* pieces, int count) {
+                    std::vector<PlacedPiece> record(pieces, pieces + count);
+                    while (!queue.try_push(record)) std::this_thread::yield();
+                    wake_collector();
+                });
+            }
+            for (;;) {
+                size_t index = next_job.fetch_add(1);
+                if (index >= jobs.size() || limit.stop.load()) break;
+                int left_ms = 0;
+                if (max_time_ms > 0) {
+                    left_ms = max_time_ms - static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start_time).count());
+                    if (left_ms <= 0) {
+                        timed_out = true;
+                        limit.stop = true;
+                        break;
+                    }
+                }
+                solver.init_board(width, height, blocked);
+                solver.set_prefix(jobs[index]);
+                solver.set_config(0, left_ms);
+                SolveResult result = solver.solve();
+                if (!result.success) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    error = result.error;
+                    limit.stop = true;
+                    break;
+                }
+                solutions += result.solutions_found;
+                nodes += result.steps_explored;
+                if (result.timeout) {
+                    timed_out = true;
+                    limit.stop = true;
+                }
+            }
+            stopped_at[thread] = std::chrono::steady_clock::now();
+            running.fetch_sub(1);
+            wake_collector();
+        };
+
+        // Pass queued solutions to on_solution until every worker is done and
+        // the queue is empty; sleeps while there is nothing to pass on
+        auto collect = [&] {
+            std::vector<std::vector<PlacedPiece>> batch(BATCH_SOLUTIONS);
+            for (;;) {
+                size_t taken = 0;
+                while (taken < batch.size() && queue.try_pop(batch[taken])) taken++;
+                for (size_t i = 0; i < taken; i++) on_solution(batch[i].data(), static_cast<int>(batch[i].size()));
+                if (taken > 0) continue;
+
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                collector_sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                // Workers push before they count themselves out, so once none
+                // is running an empty queue stays empty
+                bool done = running.load() == 0;
+                if (queue.empty()) {
+                    if (done) return;
+                    wake.wait(lock);
+                }
+                collector_sleeping.store(false, std::memory_order_relaxed);
+            }
+        };
+
+        // Without a callback the calling thread is a worker too
+        std::vector<std::thread> pool;
+        for (int t = collect_solutions ? 0 : 1; t < threads; t++) pool.emplace_back(work, t);
+        if (collect_solutions) collect();
+        else work(0);
+        for (std::thread& thread : pool) thread.join();
+
+        if (max_solutions > 0 && limit.remaining.load() <= 0) {
+            auto last = *std::max_element(stopped_at.begin(), stopped_at.end());
+            stop_latency_us = std::chrono::duration<double, std::micro>(last - limit.exhausted_at).count();
+        }
+
+        SolveResult result;
+        result.error = error;
+        result.success = error.empty();
+        result.solutions_found = static_cast<int>(solutions.load());
+        result.steps_explored = nodes.load();
+        result.solving_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time).count();
+        result.timeout = timed_out.load();
+        result.engine = "bitboard";
+        return result;
+    }
+
+    // Stop every thread at its next node
+    void stop() {
+        limit.stop = true;
+    }
+
+    // Time from the reservation of the last allowed solution until the last
+    // thread had stopped, in microseconds, for the latest solve() that hit
+    // max_solutions; -1 otherwise
+    double last_stop_latency_us() const {
+        return stop_latency_us;
+    }
+
+private:
+    int threads;
+    int depth;
+    int width = 0;
+    int height = 0;
+    std::vector<std::pair<int, int>> blocked;
+    std::vector<int> piece_counts;
+    int max_solutions = 1;
+    int max_time_ms = 30000;
+    SolutionCallback on_solution;
+    SharedLimit limit;
+    double stop_latency_us = -1;
+};
+
+#endif // PENTOMINO_PARALLEL_SOLVER_H
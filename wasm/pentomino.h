@@ -0,0 +1,177 @@
+#ifndef PENTOMINO_H
+#define PENTOMINO_H
+
+/*
+ * C ABI of the pentomino solver, for embedding it without Emscripten: the
+ * native build is libpentomino.so (make lib), the WebAssembly modules wrap
+ * the same functions with embind.
+ *
+ * A solver is an opaque handle. Set the board once (blocked cells as a
+ * bitmask), optionally the piece counts, algorithm and limits, then either
+ * solve in one call or start and step with a node budget. The solutions
+ * found are kept in a buffer on the handle, up to a capacity, and can be
+ * read back until the next search. Calls on one handle must not overlap,
+ * except pentomino_stop(), which may come from any thread.
+ *
+ * Functions returning int return PENTOMINO_OK or a negative PENTOMINO_ERROR_*
+ * code; pentomino_last_error() describes the last failure on the handle.
+ * Fields are only ever appended to the structs below, and PENTOMINO_ABI_VERSION
+ * changes when anything else does.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define PENTOMINO_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#define PENTOMINO_API __attribute__((visibility("default")))
+#else
+#define PENTOMINO_API
+#endif
+
+#define PENTOMINO_ABI_VERSION 1
+
+/* Piece types, in this order: I L N P Y T U V W X Z F */
+#define PENTOMINO_PIECE_TYPES 12
+#define PENTOMINO_PIECE_CELLS 5
+
+/* Solutions kept per search unless pentomino_set_solution_capacity() says otherwise */
+#define PENTOMINO_DEFAULT_SOLUTION_CAPACITY 1024
+
+enum {
+    PENTOMINO_OK = 0,
+    PENTOMINO_ERROR_ARGUMENT = -1,  /* bad handle, size, index or name */
+    PENTOMINO_ERROR_STATE = -2,     /* step() without start(), and the like */
+    PENTOMINO_ERROR_SOLVE = -3,     /* the search could not run, e.g. cells not a multiple of 5 */
+    PENTOMINO_ERROR_MEMORY = -4
+};
+
+/* pentomino_result.timed_out: which limit ended the search early, 0 if none */
+#define PENTOMINO_TIMED_OUT 1
+#define PENTOMINO_NODE_LIMIT 2
+
+/* Cell values of pentomino_get_board() and pentomino_get_solution_board() */
+#define PENTOMINO_CELL_EMPTY (-1)
+#define PENTOMINO_CELL_BLOCKED (-2)
+
+typedef struct pentomino_solver pentomino_solver;
+
+typedef struct pentomino_piece {
+    int32_t piece;                         /* piece type, 0-11 */
+    int32_t cells[PENTOMINO_PIECE_CELLS];  /* y * width + x */
+} pentomino_piece;
+
+/*
+ * Byte offsets are fixed for readers of raw linear memory (the lean
+ * WebAssembly module): success 0, timed_out 4, solutions 8, nodes 16,
+ * solving_ms 24, engine 32; progress: nodes 0, solutions 8, elapsed_ms 16
+ */
+typedef struct pentomino_result {
+    int32_t success;
+    int32_t timed_out;    /* PENTOMINO_TIMED_OUT or PENTOMINO_NODE_LIMIT when a limit stopped it */
+    int64_t solutions;
+    int64_t nodes;
+    int64_t solving_ms;
+    const char* engine;   /* static string: "bitboard", "grid", "dlx", "cells", "rowset", "hybrid" */
+} pentomino_result;
+
+typedef struct pentomino_progress {
+    int64_t nodes;
+    int64_t solutions;
+    int64_t elapsed_ms;
+} pentomino_progress;
+
+PENTOMINO_API int pentomino_abi_version(void);
+
+/* NULL when out of memory */
+PENTOMINO_API pentomino_solver* pentomino_create(void);
+PENTOMINO_API void pentomino_destroy(pentomino_solver* solver);
+
+/* Description of the last failed call on this handle, "" if none */
+PENTOMINO_API const char* pentomino_last_error(const pentomino_solver* solver);
+
+/*
+ * Board of width x height cells; blocked has ceil(width * height / 8) bytes,
+ * bit y * width + x (LSB first) set for a blocked cell. NULL blocks nothing.
+ */
+PENTOMINO_API int pentomino_set_board(pentomino_solver* solver, int width, int height, const uint8_t* blocked);
+
+/*
+ * How many of each piece type to place (PENTOMINO_PIECE_TYPES entries);
+ * NULL restores the default of one full set per 60 open cells
+ */
+PENTOMINO_API int pentomino_set_piece_counts(pentomino_solver* solver, const int32_t* counts);
+
+/* "backtracking" (default), "dancing-links", "dancing-cells", "bit-parallel" or "hybrid" */
+PENTOMINO_API int pentomino_set_algorithm(pentomino_solver* solver, const char* name);
+
+/* 0 = unlimited for either; the defaults are 1 solution and 30000 ms */
+PENTOMINO_API int pentomino_set_limits(pentomino_solver* solver, int32_t max_solutions, int32_t max_time_ms);
+
+/*
+ * Node budget for the whole search, 0 = unlimited (the default). The search
+ * stops after exactly max_nodes nodes with timed_out = PENTOMINO_NODE_LIMIT,
+ * at the same node on every machine.
+ */
+PENTOMINO_API int pentomino_set_node_limit(pentomino_solver* solver, int64_t max_nodes);
+
+/*
+ * Nonzero: no wall-clock checks during the search, so max_time_ms is ignored
+ * and the same board and limits always explore the same nodes
+ */
+PENTOMINO_API int pentomino_set_deterministic(pentomino_solver* solver, int enabled);
+
+/* Solutions kept per search (0 keeps none); the rest are only counted */
+PENTOMINO_API int pentomino_set_solution_capacity(pentomino_solver* solver, int32_t capacity);
+
+/* Whole search in one call; result may be NULL */
+PENTOMINO_API int pentomino_solve(pentomino_solver* solver, pentomino_result* result);
+
+/*
+ * The same search in slices: start() checks the board, each step() searches
+ * about node_budget more nodes (0 = to the end) and returns 1 once the
+ * search is over, 0 while there is more, or an error. Only the bitboard
+ * engine (backtracking) pauses; the others finish in their first step.
+ */
+PENTOMINO_API int pentomino_start(pentomino_solver* solver);
+PENTOMINO_API int pentomino_step(pentomino_solver* solver, int64_t node_budget);
+
+/* Result of the latest search, so far if it is still being stepped */
+PENTOMINO_API int pentomino_get_result(const pentomino_solver* solver, pentomino_result* result);
+
+/* Ends a running search at its next node; safe from any thread */
+PENTOMINO_API void pentomino_stop(pentomino_solver* solver);
+
+/* Counters of the latest search, as of its last completed step */
+PENTOMINO_API int pentomino_get_progress(const pentomino_solver* solver, pentomino_progress* progress);
+
+/*
+ * Board of width * height cells after a search: PENTOMINO_CELL_EMPTY,
+ * PENTOMINO_CELL_BLOCKED or the id of the covering piece in the first
+ * solution, type + 12 * copy for boards with several copies of a type
+ */
+PENTOMINO_API int pentomino_get_board(const pentomino_solver* solver, int32_t* cells);
+
+/* Solutions kept by the latest search */
+PENTOMINO_API int32_t pentomino_solution_count(const pentomino_solver* solver);
+
+/*
+ * Pieces of kept solution index, into pieces (room for capacity); returns
+ * the number of pieces in the solution, which may exceed capacity, or an
+ * error
+ */
+PENTOMINO_API int pentomino_get_solution(const pentomino_solver* solver, int32_t index,
+                                         pentomino_piece* pieces, int32_t capacity);
+
+/* Kept solution index as a board, with the cell values of pentomino_get_board() */
+PENTOMINO_API int pentomino_get_solution_board(const pentomino_solver* solver, int32_t index, int32_t* cells);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PENTOMINO_H */
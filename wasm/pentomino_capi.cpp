@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+#include "pentomino.h"
+#include "pentomino_solver.h"
+
+// C ABI over PentominoSolver (pentomino.h). Everything C++ stays on this
+// side: exceptions become status codes, and the board is kept as given so
+// every search starts from it again (a search writes its first solution
+// onto the solver's board).
+
+static_assert(offsetof(pentomino_result, solutions) == 8 && offsetof(pentomino_result, nodes) == 16 &&
+              offsetof(pentomino_result, solving_ms) == 24 && offsetof(pentomino_result, engine) == 32,
+              "pentomino_result layout is part of the ABI");
+static_assert(offsetof(pentomino_progress, solutions) == 8 && offsetof(pentomino_progress, elapsed_ms) == 16,
+              "pentomino_progress layout is part of the ABI");
+static_assert(sizeof(pentomino_piece) == 24, "pentomino_piece layout is part of the ABI");
+
+struct pentomino_solver {
+    PentominoSolver solver;
+    int width = 0;
+    int height = 0;
+    std::vector<std::pair<int, int>> blocked;
+    bool has_board = false;
+    bool started = false;      // start() succeeded, step() may run
+    bool done = true;          // the search reached its end
+    std::string error;
+    int max_solutions = 1;     // as last set, for set_config() with a node limit
+    int max_time_ms = 30000;
+
+    // Solutions kept by the running search, pieces_per_solution each
+    int capacity = PENTOMINO_DEFAULT_SOLUTION_CAPACITY;
+    int pieces_per_solution = 0;
+    std::vector<PlacedPiece> kept;
+
+    pentomino_solver() {
+        solver.set_solution_callback([this](const PlacedPiece* pieces, int count) {
+            pieces_per_solution = count;
+            if (kept.size() < static_cast<size_t>(capacity) * count) kept.insert(kept.end(), pieces, pieces + count);
+        });
+    }
+
+    int fail(int code, std::string message) {
+        error = std::move(message);
+        return code;
+    }
+
+    int kept_solutions() const {
+        return pieces_per_solution > 0 ? static_cast<int>(kept.size() / pieces_per_solution) : 0;
+    }
+};
+
+namespace {
+
+// Run a call, turning what it throws into a status code
+template <typename Call>
+int guarded(pentomino_solver* handle, Call call) {
+    try {
+        return call();
+    } catch (const std::bad_alloc&) {
+        return handle->fail(PENTOMINO_ERROR_MEMORY, "Out of memory");
+    } catch (const std::exception& e) {
+        return handle->fail(PENTOMINO_ERROR_SOLVE, e.what());
+    }
+}
+
+void fill_result(const SolveResult& solved, pentomino_result* result) {
+    result->success = solved.success;
+    result->timed_out = solved.timeout ? PENTOMINO_TIMED_OUT : solved.node_limit ? PENTOMINO_NODE_LIMIT : 0;
+    result->solutions = solved.solutions_found;
+    result->nodes = solved.steps_explored;
+    result->solving_ms = solved.solving_time;
+    result->engine = solved.engine;
+}
+
+// Write solution pieces as board cells, ids as PentominoSolver::write_solution()
+void paint_solution(const PlacedPiece* pieces, int count, int32_t* cells) {
+    int copies[PIECE_TYPES] = {};
+    for (int i = 0; i < count; i++) {
+        int id = pieces[i].piece + PIECE_TYPES * copies[pieces[i].piece]++;
+        for (int cell : pieces[i].cells) cells[cell] = id;
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+int pentomino_abi_version(void) {
+    return PENTOMINO_ABI_VERSION;
+}
+
+pentomino_solver* pentomino_create(void) {
+    try {
+        return new pentomino_solver();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void pentomino_destroy(pentomino_solver* solver) {
+    delete solver;
+}
+
+const char* pentomino_last_error(const pentomino_solver* solver) {
+    return solver ? solver->error.c_str() : "No solver";
+}
+
+int pentomino_set_board(pentomino_solver* solver, int width, int height, const uint8_t* blocked) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    if (width <= 0 || height <= 0 || static_cast<long long>(width) * height > (1 << 20)) {
+        return solver->fail(PENTOMINO_ERROR_ARGUMENT, "Invalid board size");
+    }
+    return guarded(solver, [&]() -> int {
+        solver->blocked.clear();
+        for (int cell = 0; blocked && cell < width * height; cell++) {
+            if (blocked[cell >> 3] >> (cell & 7) & 1) solver->blocked.emplace_back(cell % width, cell / width);
+        }
+        solver->width = width;
+        solver->height = height;
+        solver->has_board = true;
+        solver->started = false;
+        solver->done = true;
+        solver->kept.clear();
+        solver->solver.init_board(width, height, solver->blocked);
+        return PENTOMINO_OK;
+    });
+}
+
+int pentomino_set_piece_counts(pentomino_solver* solver, const int32_t* counts) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    return guarded(solver, [&]() -> int {
+        solver->solver.set_piece_counts(counts ? std::vector<int>(counts, counts + PIECE_TYPES) : std::vector<int>());
+        return PENTOMINO_OK;
+    });
+}
+
+int pentomino_set_algorithm(pentomino_solver* solver, const char* name) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    if (!name || !solver->solver.set_algorithm(name)) {
+        return solver->fail(PENTOMINO_ERROR_ARGUMENT, std::string("Unknown algorithm: ") + (name ? name : "(null)"));
+    }
+    return PENTOMINO_OK;
+}
+
+int pentomino_set_limits(pentomino_solver* solver, int32_t max_solutions, int32_t max_time_ms) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    if (max_solutions < 0 || max_time_ms < 0) return solver->fail(PENTOMINO_ERROR_ARGUMENT, "Negative limit");
+    solver->max_solutions = max_solutions;
+    solver->max_time_ms = max_time_ms;
+    solver->solver.set_config(max_solutions, max_time_ms);
+    return PENTOMINO_OK;
+}
+
+int pentomino_set_node_limit(pentomino_solver* solver, int64_t max_nodes) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    if (max_nodes < 0) return solver->fail(PENTOMINO_ERROR_ARGUMENT, "Negative limit");
+    solver->solver.set_config(solver->max_solutions, solver->max_time_ms, max_nodes);
+    return PENTOMINO_OK;
+}
+
+int pentomino_set_deterministic(pentomino_solver* solver, int enabled) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    solver->solver.set_deterministic(enabled != 0);
+    return PENTOMINO_OK;
+}
+
+int pentomino_set_solution_capacity(pentomino_solver* solver, int32_t capacity) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    if (capacity < 0) return solver->fail(PENTOMINO_ERROR_ARGUMENT, "Negative capacity");
+    solver->capacity = capacity;
+    return PENTOMINO_OK;
+}
+
+int pentomino_start(pentomino_solver* solver) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    if (!solver->has_board) return solver->fail(PENTOMINO_ERROR_STATE, "No board set");
+    return guarded(solver, [&]() -> int {
+        solver->started = false;
+        solver->done = true;
+        solver->kept.clear();
+        solver->pieces_per_solution = 0;
+        solver->error.clear();
+        solver->solver.init_board(solver->width, solver->height, solver->blocked);
+        if (!solver->solver.start()) return solver->fail(PENTOMINO_ERROR_SOLVE, solver->solver.result().error);
+        solver->started = true;
+        solver->done = false;
+        return PENTOMINO_OK;
+    });
+}
+
+int pentomino_step(pentomino_solver* solver, int64_t node_budget) {
+    if (!solver) return PENTOMINO_ERROR_ARGUMENT;
+    if (!solver->started) return solver->fail(PENTOMINO_ERROR_STATE, "No search started");
+    if (node_budget < 0) return solver->fail(PENTOMINO_ERROR_ARGUMENT, "Negative node budget");
+    if (solver->done) return 1;
+    return guarded(solver, [&]() -> int {
+        solver->done = solver->solver.step(node_budget);
+        if (solver->done) {
+            SolveResult solved = solver->solver.result();
+            if (!solved.success) return solver->fail(PENTOMINO_ERROR_SOLVE, solved.error);
+        }
+        return solver->done ? 1 : 0;
+    });
+}
+
+int pentomino_solve(pentomino_solver* solver, pentomino_result* result) {
+    int status = pentomino_start(solver);
+    if (status == PENTOMINO_OK) {
+        status = pentomino_step(solver, 0);
+        if (status == 1) status = PENTOMINO_OK;
+    }
+    if (result && solver) {
+        if (status == PENTOMINO_OK) {
+            pentomino_get_result(solver, result);
+        } else {
+            *result = pentomino_result();
+            result->engine = "";
+        }
+    }
+    return status;
+}
+
+int pentomino_get_result(const pentomino_solver* solver, pentomino_result* result) {
+    if (!solver || !result) return PENTOMINO_ERROR_ARGUMENT;
+    fill_result(solver->solver.result(), result);
+    return PENTOMINO_OK;
+}
+
+void pentomino_stop(pentomino_solver* solver) {
+    if (solver) solver->solver.stop();
+}
+
+int pentomino_get_progress(const pentomino_solver* solver, pentomino_progress* progress) {
+    if (!solver || !progress) return PENTOMINO_ERROR_ARGUMENT;
+    SolveProgress current = solver->solver.get_progress();
+    progress->nodes = current.steps_explored;
+    progress->solutions = current.solutions_found;
+    progress->elapsed_ms = current.time_elapsed;
+    return PENTOMINO_OK;
+}
+
+int pentomino_get_board(const pentomino_solver* solver, int32_t* cells) {
+    if (!solver || !cells || !solver->has_board) return PENTOMINO_ERROR_ARGUMENT;
+    const int* board = solver->solver.get_cells();
+    std::copy(board, board + solver->width * solver->height, cells);
+    return PENTOMINO_OK;
+}
+
+int32_t pentomino_solution_count(const pentomino_solver* solver) {
+    return solver ? solver->kept_solutions() : 0;
+}
+
+int pentomino_get_solution(const pentomino_solver* solver, int32_t index,
+                           pentomino_piece* pieces, int32_t capacity) {
+    if (!solver || index < 0 || index >= solver->kept_solutions() || (capacity > 0 && !pieces)) {
+        return PENTOMINO_ERROR_ARGUMENT;
+    }
+    const PlacedPiece* solution = solver->kept.data() + static_cast<size_t>(index) * solver->pieces_per_solution;
+    for (int i = 0; i < solver->pieces_per_solution && i < capacity; i++) {
+        pieces[i].piece = solution[i].piece;
+        std::copy(solution[i].cells, solution[i].cells + PIECE_CELLS, pieces[i].cells);
+    }
+    return solver->pieces_per_solution;
+}
+
+int pentomino_get_solution_board(const pentomino_solver* solver, int32_t index, int32_t* cells) {
+    if (!solver || !cells || index < 0 || index >= solver->kept_solutions()) return PENTOMINO_ERROR_ARGUMENT;
+    int size = solver->width * solver->height;
+    std::fill(cells, cells + size, PENTOMINO_CELL_EMPTY);
+    for (const auto& cell : solver->blocked) cells[cell.second * solver->width + cell.first] = PENTOMINO_CELL_BLOCKED;
+    paint_solution(solver->kept.data() + static_cast<size_t>(index) * solver->pieces_per_solution,
+                   solver->pieces_per_solution, cells);
+    return PENTOMINO_OK;
+}
+
+} // extern "C"
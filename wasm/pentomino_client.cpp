@@ -0,0 +1,191 @@
+// Command-line client for pentomino_daemon: sends solve requests over the Unix
+// socket and prints each result, for scripts and for poking at a running daemon.
+//
+//   pentomino_client --board 10x6 --max-solutions 0 --stream
+//   pentomino_client --board 8x8 --blocked 3,3 --blocked 4,3 --blocked 3,4 --blocked 4,4
+//   pentomino_client --board 10x6 --max-solutions 0 --concurrent 8 --cancel-after 100
+//   pentomino_client --board 12x10 --max-solutions 0 --max-time 0 --batch
+//   pentomino_client --board 8x8 --blocked 3,3 --blocked 4,3 --blocked 3,4 --blocked 4,4 --repeat 200
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "daemon_protocol.h"
+
+// Piece type order of pieces.h
+static const char PIECE_LETTERS[] = "ILNPYTUVWXZF";
+
+static const char* status_name(ReplyStatus status) {
+    switch (status) {
+        case ReplyStatus::OK: return "ok";
+        case ReplyStatus::CANCELLED: return "cancelled";
+        default: return "error";
+    }
+}
+
+static void print_usage() {
+    std::printf("usage: pentomino_client [--socket PATH] [--board WxH] [--blocked X,Y]... "
+                "[--pieces 111111111111] [--algorithm NAME] [--max-solutions N] [--max-time MS] "
+                "[--stream] [--batch] [--concurrent N] [--repeat N] [--cancel-after MS] [--print]\n");
+}
+
+int main(int argc, char** argv) {
+    std::string path = "/tmp/pentomino.sock";
+    SolveRequest request;
+    request.width = 10;
+    request.height = 6;
+    std::vector<std::pair<int, int>> blocked;
+    int concurrent = 1;
+    int repeat = 1;
+    int cancel_after_ms = -1;
+    bool print_board = false;
+
+    for (int i = 1; i < argc; i++) {
+        auto next = [&]() { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* arg = argv[i];
+        const char* value = nullptr;
+        if (std::strcmp(arg, "--stream") == 0) {
+            request.flags |= FLAG_STREAM;
+        } else if (std::strcmp(arg, "--batch") == 0) {
+            request.flags |= FLAG_BATCH;
+        } else if (std::strcmp(arg, "--print") == 0) {
+            print_board = true;
+        } else if (!(value = next())) {
+            print_usage();
+            return 1;
+        } else if (std::strcmp(arg, "--socket") == 0) {
+            path = value;
+        } else if (std::strcmp(arg, "--board") == 0) {
+            if (std::sscanf(value, "%dx%d", &request.width, &request.height) != 2) {
+                print_usage();
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--blocked") == 0) {
+            int x, y;
+            if (std::sscanf(value, "%d,%d", &x, &y) != 2) {
+                print_usage();
+                return 1;
+            }
+            blocked.emplace_back(x, y);
+        } else if (std::strcmp(arg, "--pieces") == 0) {
+            request.piece_counts.clear();
+            for (const char* c = value; *c && request.piece_counts.size() < PIECE_TYPES; c++) {
+                request.piece_counts.push_back(*c - '0');
+            }
+        } else if (std::strcmp(arg, "--algorithm") == 0) {
+            if (!parse_solver_algorithm(value, request.algorithm)) {
+                std::fprintf(stderr, "unknown algorithm '%s'\n", value);
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--max-solutions") == 0) {
+            request.max_solutions = std::atoi(value);
+        } else if (std::strcmp(arg, "--max-time") == 0) {
+            request.max_time_ms = std::atoi(value);
+        } else if (std::strcmp(arg, "--concurrent") == 0) {
+            concurrent = std::max(1, std::atoi(value));
+        } else if (std::strcmp(arg, "--repeat") == 0) {
+            repeat = std::max(1, std::atoi(value));
+        } else if (std::strcmp(arg, "--cancel-after") == 0) {
+            cancel_after_ms = std::atoi(value);
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    request.blocked.assign(request.width * request.height, 0);
+    for (const auto& cell : blocked) {
+        if (cell.first >= 0 && cell.first < request.width && cell.second >= 0 && cell.second < request.height) {
+            request.blocked[cell.second * request.width + cell.first] = 1;
+        }
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::perror(path.c_str());
+        return 1;
+    }
+
+    // Rounds of `concurrent` requests, one round after the other
+    std::vector<double> latencies;
+    int remaining = 0;
+    for (int round = 0; round < repeat && remaining == 0; round++) {
+        const uint32_t first_id = static_cast<uint32_t>(round * concurrent + 1);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < concurrent; i++) {
+            request.id = first_id + i;
+            write_frame(fd, encode_solve(request));
+        }
+        std::thread canceller;
+        if (cancel_after_ms >= 0) {
+            canceller = std::thread([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(cancel_after_ms));
+                for (int i = 0; i < concurrent; i++) {
+                    MessageWriter cancel(MessageType::CANCEL, first_id + i);
+                    write_frame(fd, cancel.bytes());
+                }
+            });
+        }
+
+        std::map<uint32_t, int> streamed;
+        remaining = concurrent;
+        std::vector<uint8_t> payload;
+        while (remaining > 0 && read_frame(fd, payload)) {
+            MessageReader in(payload.data(), payload.size());
+            auto type = static_cast<MessageType>(in.u8());
+            uint32_t id = in.u32();
+            if (type == MessageType::SOLUTION) {
+                uint32_t index;
+                std::vector<PlacedPiece> pieces;
+                if (decode_solution(in, index, pieces)) streamed[id]++;
+                continue;
+            }
+            SolveReply reply;
+            if (type != MessageType::RESULT || !decode_reply(in, reply)) break;
+            remaining--;
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            latencies.push_back(ms);
+            if (repeat > 1) continue;
+            std::printf("request %u: %s, %d solutions, %lld nodes, %d ms solve, %.1f ms round trip, engine %s",
+                        id, status_name(reply.status), reply.solutions, reply.nodes, reply.ms, ms,
+                        reply.engine.empty() ? "-" : reply.engine.c_str());
+            if (request.flags & FLAG_STREAM) std::printf(", %d streamed", streamed[id]);
+            if (!reply.error.empty()) std::printf(" (%s)", reply.error.c_str());
+            std::printf("\n");
+            if (print_board && reply.status == ReplyStatus::OK && reply.board.size() == static_cast<size_t>(request.width * request.height)) {
+                for (int y = 0; y < request.height; y++) {
+                    for (int x = 0; x < request.width; x++) {
+                        int cell = reply.board[y * request.width + x];
+                        std::printf("%c", cell == -2 ? '#' : cell < 0 ? '.' : PIECE_LETTERS[cell % PIECE_TYPES]);
+                    }
+                    std::printf("\n");
+                }
+            }
+        }
+        if (canceller.joinable()) canceller.join();
+    }
+
+    if (repeat > 1 && !latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&](double p) {
+            return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))];
+        };
+        std::printf("%zu requests: round trip p50 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+                    latencies.size(), percentile(0.50), percentile(0.99), latencies.back());
+    }
+
+    ::close(fd);
+    return remaining == 0 ? 0 : 1;
+}
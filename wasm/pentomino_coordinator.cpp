@@ -0,0 +1,687 @@
+// Distributed enumeration: the coordinator runs the top levels of the search
+// itself, ships every partial cover that survives as a subtree job to worker
+// processes, and merges their counts and solutions. Workers are this binary
+// in --worker mode, talking the daemon framing (daemon_protocol.h) on stdin
+// and stdout, so anything that connects two pipes can host one; locally the
+// coordinator forks them on socketpairs.
+//
+// Jobs are numbered in search order and carry the branch path that reached
+// them, so a run is reproducible: the same board and depth always give the
+// same jobs and per-job counts, which --manifest writes out for comparison.
+// A worker that dies loses only its current job, which is handed to another
+// worker; solutions of a job are only emitted once the job is done.
+//
+// Subtree sizes vary by orders of magnitude, so static jobs alone leave
+// workers idle behind a few huge ones. Once the queue runs dry the
+// coordinator asks busy workers to STEAL: between search slices the worker
+// splits the untried alternatives at the shallowest open level of its stack
+// (the oldest, so the biggest) and donates half of them back as new jobs,
+// unless they are estimated below MIN_DONATION_NODES. Each worker has at most
+// one steal outstanding and is asked again only STEAL_INTERVAL after its job
+// started or its last answer, which bounds the messaging. Donated jobs belong
+// to the top-level job they were split from, and that job is only reported
+// once all of them are done, so the manifest does not change with donation.
+//
+// Solutions come out as trees finish, in no fixed order. --ordered emits them
+// in the order of the sequential search instead: workers tag each solution
+// with its branch path, a finished tree is sorted by path and held until
+// every tree before it is out. Only top-level jobs within --window of the
+// oldest one not emitted yet are handed out, which bounds what is held.
+//
+//   pentomino_coordinator --board 10x6 --workers 4 --depth 3
+//   pentomino_coordinator --board 12x10 --pieces 222222222222 --workers 8 --manifest jobs.txt
+//   pentomino_coordinator --board 10x6 --stream --kill-after 100     (re-issue demo)
+//   pentomino_coordinator --board 10x6 --workers 4 --depth 1 --no-donate
+//   pentomino_coordinator --board 10x6 --stream --ordered > solutions.txt
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "daemon_protocol.h"
+
+// Piece type order of pieces.h
+static const char PIECE_LETTERS[] = "ILNPYTUVWXZF";
+
+// Jobs carry cells as u16
+static constexpr int MAX_CELLS = 65535;
+
+// Nodes a worker searches between looks at its input for STEAL and CANCEL
+static constexpr long long WORKER_SLICE_NODES = 1 << 16;
+
+// Smallest estimated subtree worth shipping to another worker
+static constexpr long long MIN_DONATION_NODES = 1 << 16;
+
+// Least time between steals from one worker
+static constexpr auto STEAL_INTERVAL = std::chrono::milliseconds(5);
+
+// Default --window: top-level jobs ahead of the oldest unemitted one, per worker
+static constexpr int ORDERED_WINDOW_PER_WORKER = 4;
+
+static void print_usage() {
+    std::printf("usage: pentomino_coordinator [--board WxH] [--blocked X,Y]... [--pieces 111111111111] "
+                "[--workers N] [--depth K] [--stream] [--ordered] [--window JOBS] [--no-donate]\n"
+                "       [--manifest FILE] [--kill-after JOBS]\n"
+                "       pentomino_coordinator --worker\n");
+}
+
+static std::vector<std::pair<int, int>> blocked_cells(const SolveRequest& request) {
+    std::vector<std::pair<int, int>> blocked;
+    for (int i = 0; i < request.width * request.height; i++) {
+        if (request.blocked[i]) blocked.emplace_back(i % request.width, i / request.width);
+    }
+    return blocked;
+}
+
+// Worker mode: a SOLVE frame with the board, then jobs until the input closes.
+// A job runs in slices; STEAL and CANCEL for it are handled in between.
+static int run_worker(int in, int out) {
+    std::vector<uint8_t> payload;
+    SolveRequest board;
+    if (!read_frame(in, payload)) return 1;
+    {
+        MessageReader reader(payload.data(), payload.size());
+        if (static_cast<MessageType>(reader.u8()) != MessageType::SOLVE) return 1;
+        reader.u32();
+        if (!decode_solve(reader, board)) return 1;
+    }
+    const std::vector<std::pair<int, int>> blocked = blocked_cells(board);
+    const bool stream = (board.flags & FLAG_STREAM) != 0;
+    const bool ordered = (board.flags & FLAG_ORDERED) != 0;
+
+    PentominoSolver solver;
+    solver.set_piece_counts(board.piece_counts);
+    solver.set_config(0, 0);
+    SubtreeJob job;
+    uint32_t streamed = 0;
+    bool writable = true;
+    std::vector<uint8_t> path;
+    if (stream) {
+        solver.set_solution_callback([&](const PlacedPiece* pieces, int count) {
+            if (writable && ordered) {
+                // The job's own branches, then the search's below them
+                path.assign(job.path.begin(), job.path.end());
+                path.resize(job.path.size() + count);
+                path.resize(job.path.size() + solver.solution_path(path.data() + job.path.size()));
+                writable = write_frame(out, encode_solution(job.index, streamed++, pieces, count,
+                                                            path.data(), static_cast<int>(path.size())));
+            } else if (writable) {
+                writable = write_frame(out, encode_solution(job.index, streamed++, pieces, count));
+            }
+            if (!writable) solver.stop();
+        });
+    }
+
+    // STEAL gets a DONATION, empty when there is no job or nothing worth
+    // giving; CANCEL stops the job. Anything else is a protocol error.
+    bool running = false;
+    auto control = [&](MessageType type, uint32_t index) {
+        if (type == MessageType::CANCEL) {
+            if (running && index == job.index) solver.stop();
+            return true;
+        }
+        if (type != MessageType::STEAL) return false;
+        std::vector<SubtreeJob> donated;
+        long long estimate = 0;
+        if (running && index == job.index) {
+            estimate = solver.donate(MIN_DONATION_NODES, [&](const PlacedPiece* pieces, int count, const uint8_t* path, int levels) {
+                SubtreeJob split;
+                split.path = job.path;
+                split.path.insert(split.path.end(), path, path + levels);
+                split.pieces.assign(pieces, pieces + count);
+                donated.push_back(std::move(split));
+            });
+        }
+        writable = writable && write_frame(out, encode_donation(index, static_cast<uint64_t>(estimate), donated));
+        return true;
+    };
+
+    while (writable && read_frame(in, payload)) {
+        MessageReader reader(payload.data(), payload.size());
+        auto type = static_cast<MessageType>(reader.u8());
+        uint32_t index = reader.u32();
+        if (type != MessageType::JOB) {
+            if (!reader.ok() || !control(type, index)) return 1;
+            continue;
+        }
+        job.index = index;
+        if (!decode_job(reader, board.width * board.height, job)) return 1;
+
+        solver.init_board(board.width, board.height, blocked);
+        solver.set_prefix(job.pieces);
+        streamed = 0;
+        running = solver.start();
+        while (running && !solver.step(WORKER_SLICE_NODES)) {
+            pollfd waiting{in, POLLIN, 0};
+            while (writable && ::poll(&waiting, 1, 0) > 0) {
+                if (!read_frame(in, payload)) return 0;
+                MessageReader message(payload.data(), payload.size());
+                auto message_type = static_cast<MessageType>(message.u8());
+                uint32_t message_index = message.u32();
+                if (!message.ok() || !control(message_type, message_index)) return 1;
+            }
+        }
+        running = false;
+        SolveResult result = solver.result();
+        if (!result.success) return 1;
+        writable = writable && write_frame(out, encode_job_done(job.index, result.solutions_found, result.steps_explored));
+    }
+    return 0;
+}
+
+struct Worker {
+    pid_t pid = -1;
+    int fd = -1;
+    long long job = -1;               // job in flight, -1 when idle
+    bool stealing = false;            // STEAL sent, DONATION not back yet
+    std::chrono::steady_clock::time_point since;  // job start or last DONATION
+    uint64_t nodes = 0;               // searched for jobs that counted
+};
+
+struct Solution {
+    std::vector<uint8_t> path;        // --ordered only
+    std::vector<PlacedPiece> pieces;
+};
+
+struct JobState {
+    bool done = false;
+    bool cancelled = false;           // voided with its lost ancestor, messages ignored
+    uint32_t root = 0;                // top-level job it was split from
+    uint32_t open = 0;                // top-level jobs: jobs of the tree not done yet
+    uint64_t estimate = 0;            // donated jobs: estimated nodes when split off
+    uint32_t solutions = 0;
+    uint64_t nodes = 0;
+    std::vector<uint32_t> children;   // jobs donated from this one
+    std::vector<Solution> pending;    // streamed, not yet emitted
+    std::vector<std::string> output;  // --ordered top-level jobs: the finished tree's boards
+};
+
+// Fork a worker on one end of a socketpair, as stdin and stdout of --worker.
+// Close-on-exec keeps the other workers' ends out of it, so closing one end
+// always reaches the worker as end of input.
+static bool spawn_worker(const char* self, const std::vector<uint8_t>& setup, Worker& worker) {
+    int ends[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, ends) < 0) return false;
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        ::close(ends[0]);
+        ::close(ends[1]);
+        return false;
+    }
+    if (pid == 0) {
+        ::dup2(ends[1], 0);
+        ::dup2(ends[1], 1);
+        ::close(ends[0]);
+        ::close(ends[1]);
+        ::execl(self, self, "--worker", static_cast<char*>(nullptr));
+        std::_Exit(127);
+    }
+    ::close(ends[1]);
+    worker.pid = pid;
+    worker.fd = ends[0];
+    worker.job = -1;
+    return write_frame(worker.fd, setup);
+}
+
+static void retire_worker(Worker& worker) {
+    if (worker.fd >= 0) ::close(worker.fd);
+    if (worker.pid > 0) {
+        ::kill(worker.pid, SIGKILL);
+        ::waitpid(worker.pid, nullptr, 0);
+    }
+    worker.fd = -1;
+    worker.pid = -1;
+}
+
+static std::string board_string(const SolveRequest& request, const std::vector<PlacedPiece>& pieces) {
+    std::string cells(request.width * request.height, '.');
+    for (int i = 0; i < request.width * request.height; i++) {
+        if (request.blocked[i]) cells[i] = '#';
+    }
+    for (const PlacedPiece& placed : pieces) {
+        for (int cell : placed.cells) cells[cell] = PIECE_LETTERS[placed.piece];
+    }
+    std::string rows;
+    for (int y = 0; y < request.height; y++) {
+        if (y > 0) rows += '/';
+        rows.append(cells, y * request.width, request.width);
+    }
+    return rows;
+}
+
+int main(int argc, char** argv) {
+    SolveRequest request;
+    request.width = 10;
+    request.height = 6;
+    std::vector<std::pair<int, int>> blocked;
+    int workers_wanted = static_cast<int>(::sysconf(_SC_NPROCESSORS_ONLN));
+    int depth = 3;
+    const char* manifest_path = nullptr;
+    long long kill_after = -1;
+    bool donate = true;
+    int window = 0;
+
+    for (int i = 1; i < argc; i++) {
+        auto next = [&]() { return i + 1 < argc ? argv[++i] : nullptr; };
+        const char* arg = argv[i];
+        const char* value = nullptr;
+        if (std::strcmp(arg, "--worker") == 0) {
+            std::signal(SIGPIPE, SIG_IGN);
+            return run_worker(0, 1);
+        } else if (std::strcmp(arg, "--stream") == 0) {
+            request.flags |= FLAG_STREAM;
+        } else if (std::strcmp(arg, "--ordered") == 0) {
+            request.flags |= FLAG_ORDERED;
+        } else if (std::strcmp(arg, "--no-donate") == 0) {
+            donate = false;
+        } else if (!(value = next())) {
+            print_usage();
+            return 1;
+        } else if (std::strcmp(arg, "--board") == 0) {
+            if (std::sscanf(value, "%dx%d", &request.width, &request.height) != 2) {
+                print_usage();
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--blocked") == 0) {
+            int x, y;
+            if (std::sscanf(value, "%d,%d", &x, &y) != 2) {
+                print_usage();
+                return 1;
+            }
+            blocked.emplace_back(x, y);
+        } else if (std::strcmp(arg, "--pieces") == 0) {
+            request.piece_counts.clear();
+            for (const char* c = value; *c && request.piece_counts.size() < PIECE_TYPES; c++) {
+                request.piece_counts.push_back(*c - '0');
+            }
+        } else if (std::strcmp(arg, "--workers") == 0) {
+            workers_wanted = std::atoi(value);
+        } else if (std::strcmp(arg, "--depth") == 0) {
+            depth = std::atoi(value);
+        } else if (std::strcmp(arg, "--window") == 0) {
+            window = std::atoi(value);
+        } else if (std::strcmp(arg, "--manifest") == 0) {
+            manifest_path = value;
+        } else if (std::strcmp(arg, "--kill-after") == 0) {
+            kill_after = std::atoll(value);
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (workers_wanted < 1) workers_wanted = 1;
+    const bool ordered = (request.flags & FLAG_ORDERED) != 0;
+    if (window < 1) window = ORDERED_WINDOW_PER_WORKER * workers_wanted;
+    if (request.width <= 0 || request.height <= 0 || request.width * request.height > MAX_CELLS) {
+        std::fprintf(stderr, "invalid board size\n");
+        return 1;
+    }
+    request.blocked.assign(request.width * request.height, 0);
+    for (const auto& cell : blocked) {
+        if (cell.first >= 0 && cell.first < request.width && cell.second >= 0 && cell.second < request.height) {
+            request.blocked[cell.second * request.width + cell.first] = 1;
+        }
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+    auto start = std::chrono::steady_clock::now();
+
+    // Expand the top of the search into jobs, in search order
+    std::vector<SubtreeJob> jobs;
+    PentominoSolver expander;
+    expander.init_board(request.width, request.height, blocked_cells(request));
+    expander.set_piece_counts(request.piece_counts);
+    expander.set_config(0, 0);
+    SolveResult top = expander.expand_jobs(depth, [&](const PlacedPiece* pieces, int count, const uint8_t* path, int levels) {
+        SubtreeJob job;
+        job.index = static_cast<uint32_t>(jobs.size());
+        job.path.assign(path, path + levels);
+        job.pieces.assign(pieces, pieces + count);
+        jobs.push_back(std::move(job));
+    });
+    if (!top.success) {
+        std::fprintf(stderr, "%s\n", top.error.c_str());
+        return 1;
+    }
+
+    const size_t roots = jobs.size();
+    std::vector<JobState> states(roots);
+    std::deque<uint32_t> queue;
+    for (const SubtreeJob& job : jobs) {
+        states[job.index].root = job.index;
+        states[job.index].open = 1;
+        queue.push_back(job.index);
+    }
+
+    const char* self = "/proc/self/exe";
+    if (::access(self, X_OK) != 0) self = argv[0];
+    const std::vector<uint8_t> setup = encode_solve(request);
+    std::vector<Worker> workers(static_cast<size_t>(workers_wanted));
+    int restarts_left = 3 * workers_wanted;
+    for (Worker& worker : workers) {
+        if (!spawn_worker(self, setup, worker)) {
+            std::perror("pentomino_coordinator: worker");
+            return 1;
+        }
+    }
+
+    size_t done = 0;                  // top-level jobs with their whole tree done
+    size_t emitted = 0;               // --ordered: top-level jobs whose solutions are out
+    size_t held = 0;                  // solutions received, not printed yet
+    size_t peak_held = 0;
+    long long reissued = 0;
+    long long steals = 0;
+    long long donations = 0;
+    uint64_t solutions = 0;
+    uint64_t nodes = static_cast<uint64_t>(top.steps_explored);
+    bool killed = false;
+    std::vector<uint8_t> payload;
+
+    // Jobs donated from a lost job are searched again with it: drop them
+    // from the queue, stop the running ones and forget the finished ones
+    auto cancel_children = [&](uint32_t index) {
+        std::vector<uint32_t> stack = states[index].children;
+        states[index].children.clear();
+        while (!stack.empty()) {
+            JobState& state = states[stack.back()];
+            uint32_t child = stack.back();
+            stack.pop_back();
+            stack.insert(stack.end(), state.children.begin(), state.children.end());
+            if (!state.done) states[state.root].open--;
+            state.cancelled = true;
+            held -= state.pending.size();
+            state.pending.clear();
+            queue.erase(std::remove(queue.begin(), queue.end(), child), queue.end());
+            for (Worker& worker : workers) {
+                if (worker.fd >= 0 && worker.job == child) {
+                    MessageWriter cancel(MessageType::CANCEL, child);
+                    write_frame(worker.fd, cancel.bytes());
+                }
+            }
+        }
+    };
+
+    auto lose_worker = [&](Worker& worker) {
+        if (worker.job >= 0 && !states[worker.job].cancelled) {
+            cancel_children(static_cast<uint32_t>(worker.job));
+            held -= states[worker.job].pending.size();
+            states[worker.job].pending.clear();
+            queue.push_front(static_cast<uint32_t>(worker.job));
+            reissued++;
+        }
+        retire_worker(worker);
+        worker.stealing = false;
+        if (restarts_left > 0 && done < roots) {
+            restarts_left--;
+            if (!spawn_worker(self, setup, worker)) retire_worker(worker);
+        }
+    };
+
+    // A finished tree: emit its solutions (--ordered: sort them into its
+    // output) and fold its counts into its top-level job, one node for each
+    // donated job's own placement
+    auto finish_tree = [&](uint32_t root) {
+        std::vector<uint32_t> stack{root};
+        std::vector<uint32_t> tree;
+        std::vector<const Solution*> found;
+        uint32_t tree_solutions = 0;
+        uint64_t tree_nodes = 0;
+        while (!stack.empty()) {
+            tree.push_back(stack.back());
+            JobState& state = states[stack.back()];
+            tree_nodes += state.nodes + (stack.back() != root ? 1 : 0);
+            stack.pop_back();
+            tree_solutions += state.solutions;
+            for (const Solution& solution : state.pending) found.push_back(&solution);
+            stack.insert(stack.end(), state.children.rbegin(), state.children.rend());
+        }
+        if (ordered) {
+            std::sort(found.begin(), found.end(), [](const Solution* a, const Solution* b) { return a->path < b->path; });
+        }
+        std::vector<std::string>& output = states[root].output;
+        for (const Solution* solution : found) {
+            std::string board = board_string(request, solution->pieces);
+            if (ordered) {
+                output.push_back(std::move(board));
+            } else {
+                std::printf("%s\n", board.c_str());
+                held--;
+            }
+        }
+        for (uint32_t index : tree) {
+            states[index].pending.clear();
+            states[index].pending.shrink_to_fit();
+        }
+        states[root].solutions = tree_solutions;
+        states[root].nodes = tree_nodes;
+        solutions += tree_solutions;
+        nodes += tree_nodes;
+        done++;
+
+        // --ordered: print every finished tree no earlier one is waiting on
+        while (emitted < roots && states[emitted].open == 0) {
+            for (const std::string& board : states[emitted].output) std::printf("%s\n", board.c_str());
+            held -= states[emitted].output.size();
+            states[emitted].output.clear();
+            states[emitted].output.shrink_to_fit();
+            emitted++;
+        }
+    };
+
+    while (done < roots) {
+        // Hand out jobs to idle workers, --ordered top-level ones only
+        // within the window
+        int idle = 0;
+        for (Worker& worker : workers) {
+            if (worker.fd < 0 || worker.job >= 0) continue;
+            if (queue.empty() || (ordered && queue.front() < roots && queue.front() >= emitted + window)) {
+                idle++;
+                continue;
+            }
+            uint32_t index = queue.front();
+            queue.pop_front();
+            worker.job = index;
+            worker.since = std::chrono::steady_clock::now();
+            if (!write_frame(worker.fd, encode_job(jobs[index]))) lose_worker(worker);
+        }
+
+        // Nothing left to hand out: split the jobs left alone longest, one
+        // per idle worker, each worker at most once per STEAL_INTERVAL
+        int timeout = -1;
+        if (donate && idle > 0) {
+            auto now = std::chrono::steady_clock::now();
+            int outstanding = 0;
+            for (const Worker& worker : workers) outstanding += worker.stealing ? 1 : 0;
+            std::vector<Worker*> victims;
+            for (Worker& worker : workers) {
+                if (worker.fd < 0 || worker.job < 0 || worker.stealing || states[worker.job].cancelled) continue;
+                auto ready = worker.since + STEAL_INTERVAL;
+                if (ready <= now) {
+                    victims.push_back(&worker);
+                } else {
+                    int wait = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(ready - now).count());
+                    timeout = timeout < 0 ? wait : std::min(timeout, wait);
+                }
+            }
+            std::sort(victims.begin(), victims.end(), [](const Worker* a, const Worker* b) { return a->since < b->since; });
+            for (Worker* victim : victims) {
+                if (outstanding >= idle) break;
+                MessageWriter steal(MessageType::STEAL, static_cast<uint32_t>(victim->job));
+                if (!write_frame(victim->fd, steal.bytes())) continue;
+                victim->stealing = true;
+                outstanding++;
+                steals++;
+            }
+        }
+
+        std::vector<pollfd> waiting;
+        std::vector<Worker*> owners;
+        for (Worker& worker : workers) {
+            if (worker.fd < 0) continue;
+            waiting.push_back({worker.fd, POLLIN, 0});
+            owners.push_back(&worker);
+        }
+        if (waiting.empty()) {
+            std::fprintf(stderr, "pentomino_coordinator: all workers lost\n");
+            return 1;
+        }
+        if (::poll(waiting.data(), waiting.size(), timeout) <= 0) continue;
+
+        for (size_t w = 0; w < waiting.size(); w++) {
+            if (!waiting[w].revents) continue;
+            Worker& worker = *owners[w];
+            if (worker.fd < 0) continue;  // lost while handling an earlier one
+            if (!read_frame(worker.fd, payload)) {
+                lose_worker(worker);
+                continue;
+            }
+            MessageReader in(payload.data(), payload.size());
+            auto type = static_cast<MessageType>(in.u8());
+            uint32_t index = in.u32();
+            if (type == MessageType::DONATION) {
+                // May answer a steal for a job that has finished since
+                uint64_t estimate;
+                std::vector<SubtreeJob> donated;
+                if (!worker.stealing || !decode_donation(in, request.width * request.height, estimate, donated)) {
+                    lose_worker(worker);
+                    continue;
+                }
+                worker.stealing = false;
+                worker.since = std::chrono::steady_clock::now();
+                if (index != worker.job || states[index].cancelled || donated.empty()) continue;
+                donations++;
+                const uint32_t root = states[index].root;
+                const uint32_t first = static_cast<uint32_t>(jobs.size());
+                states[root].open += static_cast<uint32_t>(donated.size());
+                for (SubtreeJob& split : donated) {
+                    split.index = static_cast<uint32_t>(jobs.size());
+                    states[index].children.push_back(split.index);
+                    JobState state;
+                    state.root = root;
+                    state.estimate = estimate;
+                    jobs.push_back(std::move(split));
+                    states.push_back(std::move(state));
+                }
+                // Ahead of everything else, in search order
+                for (uint32_t i = static_cast<uint32_t>(jobs.size()); i-- > first;) queue.push_front(i);
+                continue;
+            }
+            if (index != worker.job) {
+                lose_worker(worker);
+                continue;
+            }
+            JobState& state = states[index];
+            if (type == MessageType::SOLUTION) {
+                uint32_t solution_index;
+                Solution solution;
+                if (!decode_solution(in, solution_index, solution.pieces, &solution.path)) {
+                    lose_worker(worker);
+                    continue;
+                }
+                if (state.cancelled) continue;
+                state.pending.push_back(std::move(solution));
+                peak_held = std::max(peak_held, ++held);
+                continue;
+            }
+            if (type != MessageType::JOB_DONE) {
+                lose_worker(worker);
+                continue;
+            }
+            uint32_t job_solutions = in.u32();
+            uint64_t job_nodes = in.u64();
+            if (!in.ok()) {
+                lose_worker(worker);
+                continue;
+            }
+            worker.job = -1;
+            if (state.cancelled) continue;
+            state.solutions = job_solutions;
+            state.nodes = job_nodes;
+            state.done = true;
+            worker.nodes += job_nodes;
+            if (--states[state.root].open == 0) finish_tree(state.root);
+
+            // Fault injection: kill a busy worker once to exercise re-issuing
+            if (!killed && kill_after >= 0 && static_cast<long long>(done) >= kill_after) {
+                for (Worker& victim : workers) {
+                    if (victim.fd >= 0 && victim.job >= 0) {
+                        ::kill(victim.pid, SIGKILL);
+                        killed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (Worker& worker : workers) {
+        if (worker.fd >= 0) ::close(worker.fd);
+        if (worker.pid > 0) ::waitpid(worker.pid, nullptr, 0);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (manifest_path) {
+        FILE* manifest = std::fopen(manifest_path, "w");
+        if (!manifest) {
+            std::perror(manifest_path);
+            return 1;
+        }
+        for (size_t index = 0; index < roots; index++) {
+            const SubtreeJob& job = jobs[index];
+            std::fprintf(manifest, "job %u path", job.index);
+            for (size_t l = 0; l < job.path.size(); l++) std::fprintf(manifest, "%c%d", l ? '.' : ' ', job.path[l]);
+            std::fprintf(manifest, " pieces");
+            for (const PlacedPiece& placed : job.pieces) {
+                std::fprintf(manifest, " %c", PIECE_LETTERS[placed.piece]);
+                for (int i = 0; i < PIECE_CELLS; i++) std::fprintf(manifest, "%c%d", i ? ',' : ':', placed.cells[i]);
+            }
+            std::fprintf(manifest, " solutions %u nodes %llu\n", states[job.index].solutions,
+                         static_cast<unsigned long long>(states[job.index].nodes));
+        }
+        std::fprintf(manifest, "total jobs %zu solutions %llu nodes %llu\n", roots,
+                     static_cast<unsigned long long>(solutions), static_cast<unsigned long long>(nodes));
+        std::fclose(manifest);
+    }
+
+    std::fprintf(stderr, "%zu jobs at depth %d on %d workers: %llu solutions, %llu nodes, %.1f ms, %lld re-issued\n",
+                 roots, depth, workers_wanted, static_cast<unsigned long long>(solutions),
+                 static_cast<unsigned long long>(nodes), ms, reissued);
+    uint64_t least = UINT64_MAX;
+    uint64_t most = 0;
+    for (const Worker& worker : workers) {
+        least = std::min(least, worker.nodes);
+        most = std::max(most, worker.nodes);
+    }
+    std::fprintf(stderr, "nodes per worker: min %llu, max %llu; at most %zu solutions held\n",
+                 static_cast<unsigned long long>(least), static_cast<unsigned long long>(most), peak_held);
+
+    if (donate) {
+        // Donated jobs come after the job they were split from, so one
+        // backwards pass sums every subtree
+        std::vector<uint64_t> subtree(jobs.size(), 0);
+        uint64_t estimated = 0;
+        uint64_t searched = 0;
+        size_t donated = 0;
+        for (size_t index = jobs.size(); index-- > 0;) {
+            const JobState& state = states[index];
+            if (state.cancelled || index < roots) continue;
+            subtree[index] += state.nodes;
+            for (uint32_t child : state.children) subtree[index] += 1 + subtree[child];
+            donated++;
+            estimated += state.estimate;
+            searched += 1 + subtree[index];
+        }
+        std::fprintf(stderr, "%lld steals, %lld donations of %zu jobs: estimated %llu nodes, searched %llu\n",
+                     steals, donations, donated, static_cast<unsigned long long>(estimated),
+                     static_cast<unsigned long long>(searched));
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Long-running native solver daemon.
+//
+// Listens on a Unix domain socket and serves the binary protocol of
+// daemon_protocol.h. Each connection gets a reader thread that decodes frames
+// and hands SOLVE/CANCEL to the shared SolveService; replies from the
+// service's worker threads go through the connection's lock-free frame queue
+// to its writer thread (frame_queue.h). Closing a connection cancels whatever
+// it still has pending.
+//
+//   pentomino_daemon                          /tmp/pentomino.sock, one worker per core
+//   pentomino_daemon --socket PATH --threads 4
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "frame_queue.h"
+#include "solve_service.h"
+
+static volatile std::sig_atomic_t shutdown_requested = 0;
+
+static void request_shutdown(int) {
+    shutdown_requested = 1;
+}
+
+struct Connection {
+    int fd;
+    uint32_t client;
+    FrameWriter writer;              // every outgoing frame
+    std::mutex fd_mutex;             // keeps interrupt() off a closed fd
+    std::atomic<bool> done{false};   // reader finished and fd closed
+
+    Connection(int fd, uint32_t client) : fd(fd), client(client), writer(fd) {}
+
+    void send(std::vector<uint8_t> payload) {
+        writer.push(std::move(payload));
+    }
+
+    // Wake a reader blocked in read(); a no-op once the fd is closed
+    void interrupt() {
+        std::lock_guard<std::mutex> lock(fd_mutex);
+        if (fd >= 0) ::shutdown(fd, SHUT_RDWR);
+    }
+
+    // Flush what is queued, then close; later frames are dropped
+    void close() {
+        writer.close();
+        std::lock_guard<std::mutex> lock(fd_mutex);
+        ::close(fd);
+        fd = -1;
+    }
+};
+
+struct Session {
+    std::shared_ptr<Connection> connection;
+    std::thread reader;
+};
+
+static void serve_connection(std::shared_ptr<Connection> connection, SolveService& service) {
+    SolveService::Sink sink = [connection](std::vector<uint8_t> payload) {
+        connection->send(std::move(payload));
+    };
+    std::vector<uint8_t> payload;
+    while (read_frame(connection->fd, payload)) {
+        MessageReader in(payload.data(), payload.size());
+        auto type = static_cast<MessageType>(in.u8());
+        uint32_t id = in.u32();
+        if (type == MessageType::SOLVE) {
+            SolveRequest request;
+            request.id = id;
+            if (in.ok() && decode_solve(in, request)) {
+                service.submit(connection->client, request, sink);
+            } else {
+                SolveReply reply;
+                reply.id = id;
+                reply.status = ReplyStatus::ERROR;
+                reply.error = "Malformed request";
+                connection->send(encode_reply(reply));
+            }
+        } else if (type == MessageType::CANCEL && in.ok()) {
+            service.cancel(connection->client, id);
+        } else {
+            break;  // protocol error: drop the connection
+        }
+    }
+    service.cancel_client(connection->client);
+    connection->close();
+    connection->done = true;
+}
+
+int main(int argc, char** argv) {
+    std::string path = "/tmp/pentomino.sock";
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else {
+            std::printf("usage: pentomino_daemon [--socket PATH] [--threads N]\n");
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::fprintf(stderr, "socket path too long: %s\n", path.c_str());
+        return 1;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(path.c_str());
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listener, 64) < 0) {
+        std::perror("pentomino_daemon");
+        return 1;
+    }
+
+    std::signal(SIGINT, request_shutdown);
+    std::signal(SIGTERM, request_shutdown);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::printf("pentomino_daemon: %s, %d worker threads\n", path.c_str(), threads);
+    std::fflush(stdout);
+
+    {
+        SolveService service(threads);
+        std::vector<Session> sessions;
+        uint32_t next_client = 1;
+
+        while (!shutdown_requested) {
+            // Reap connections whose reader has finished
+            for (auto it = sessions.begin(); it != sessions.end();) {
+                if (it->connection->done) {
+                    it->reader.join();
+                    it = sessions.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            pollfd waiting{listener, POLLIN, 0};
+            if (::poll(&waiting, 1, 200) <= 0) continue;
+            int fd = ::accept(listener, nullptr, nullptr);
+            if (fd < 0) continue;
+            auto connection = std::make_shared<Connection>(fd, next_client++);
+            sessions.push_back({connection, std::thread(serve_connection, connection, std::ref(service))});
+        }
+
+        // Unblock the readers; each cancels its client's requests on the way out
+        for (auto& session : sessions) session.connection->interrupt();
+        for (auto& session : sessions) session.reader.join();
+    }
+
+    ::close(listener);
+    ::unlink(path.c_str());
+    return 0;
+}
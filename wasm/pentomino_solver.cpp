@@ -1,358 +1,195 @@
-#include <vector>
-#include <array>
 #include <algorithm>
-#include <chrono>
+#include <memory>
+#include <new>
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
+#include "pentomino.h"
+#include "batch_solver.h"
 
 using namespace emscripten;
 
-// Pentomino piece definitions (relative coordinates)
-const std::vector<std::vector<std::pair<int, int>>> PENTOMINO_SHAPES = {
-    // I piece
-    {{0,0}, {0,1}, {0,2}, {0,3}, {0,4}},
-    // L piece  
-    {{0,0}, {0,1}, {0,2}, {0,3}, {1,3}},
-    // N piece
-    {{0,0}, {0,1}, {1,1}, {1,2}, {1,3}},
-    // P piece
-    {{0,0}, {0,1}, {1,0}, {1,1}, {1,2}},
-    // Y piece
-    {{0,0}, {0,1}, {0,2}, {1,1}, {2,1}},
-    // T piece
-    {{0,0}, {1,0}, {2,0}, {1,1}, {1,2}},
-    // U piece
-    {{0,0}, {0,1}, {1,1}, {2,1}, {2,0}},
-    // V piece
-    {{0,0}, {0,1}, {0,2}, {1,2}, {2,2}},
-    // W piece
-    {{0,0}, {0,1}, {1,1}, {1,2}, {2,2}},
-    // X piece
-    {{1,0}, {0,1}, {1,1}, {2,1}, {1,2}},
-    // Z piece
-    {{0,0}, {1,0}, {1,1}, {1,2}, {2,2}},
-    // F piece
-    {{0,1}, {1,0}, {1,1}, {1,2}, {2,1}}
-};
-
-class PentominoSolver {
-private:
-    std::vector<std::vector<int>> board;
-    std::vector<std::vector<std::vector<std::pair<int, int>>>> all_orientations;
-    int width, height;
-    int solutions_found;
-    int max_solutions;
-    int steps_explored;
-    std::chrono::steady_clock::time_point start_time;
-    int max_time_ms;
-    bool should_stop;
-    
-    // Generate all rotations and reflections of a piece
-    std::vector<std::vector<std::pair<int, int>>> generate_orientations(
-        const std::vector<std::pair<int, int>>& shape) {
-        
-        std::vector<std::vector<std::pair<int, int>>> orientations;
-        std::vector<std::pair<int, int>> current = shape;
-        
-        // Generate 4 rotations
-        for (int rot = 0; rot < 4; rot++) {
-            // Normalize to origin
-            normalize_shape(current);
-            
-            // Add if not already present
-            if (std::find(orientations.begin(), orientations.end(), current) == orientations.end()) {
-                orientations.push_back(current);
-            }
-            
-            // Rotate 90 degrees clockwise: (x,y) -> (y,-x)
-            for (auto& cell : current) {
-                int new_x = cell.second;
-                int new_y = -cell.first;
-                cell.first = new_x;
-                cell.second = new_y;
-            }
-        }
-        
-        // Generate reflections
-        current = shape;
-        // Reflect horizontally: (x,y) -> (-x,y)
-        for (auto& cell : current) {
-            cell.first = -cell.first;
-        }
-        
-        // Generate 4 rotations of reflection
-        for (int rot = 0; rot < 4; rot++) {
-            normalize_shape(current);
-            
-            if (std::find(orientations.begin(), orientations.end(), current) == orientations.end()) {
-                orientations.push_back(current);
-            }
-            
-            for (auto& cell : current) {
-                int new_x = cell.second;
-                int new_y = -cell.first;
-                cell.first = new_x;
-                cell.second = new_y;
-            }
-        }
-        
-        return orientations;
-    }
-    
-    // Normalize shape to have minimum coordinates at origin
-    void normalize_shape(std::vector<std::pair<int, int>>& shape) {
-        if (shape.empty()) return;
-        
-        int min_x = shape[0].first;
-        int min_y = shape[0].second;
-        
-        for (const auto& cell : shape) {
-            min_x = std::min(min_x, cell.first);
-            min_y = std::min(min_y, cell.second);
-        }
-        
-        for (auto& cell : shape) {
-            cell.first -= min_x;
-            cell.second -= min_y;
-        }
-        
-        // Sort for consistent comparison
-        std::sort(shape.begin(), shape.end());
+// JavaScript-facing wrapper of the C ABI (pentomino.h), keeping the method
+// names the app has always called. Results become plain JS objects.
+class JsSolver {
+public:
+    JsSolver() : handle(pentomino_create()) {
+        if (!handle) throw std::bad_alloc();
+        // JS only reads the board, so keep no solution buffer
+        pentomino_set_solution_capacity(handle.get(), 0);
     }
-    
-    // Check if piece can be placed at position
-    bool can_place_piece(const std::vector<std::pair<int, int>>& orientation, 
-                        int start_x, int start_y) {
-        for (const auto& cell : orientation) {
-            int x = start_x + cell.first;
-            int y = start_y + cell.second;
-            
-            if (x < 0 || x >= width || y < 0 || y >= height) {
-                return false;
-            }
-            
-            if (board[y][x] != -1) {
-                return false;
+
+    void init_board(int w, int h, const std::vector<std::pair<int, int>>& blocked_cells) {
+        width = std::max(w, 0);
+        height = std::max(h, 0);
+        std::vector<uint8_t> mask((width * height + 7) / 8);
+        for (const auto& cell : blocked_cells) {
+            if (cell.first >= 0 && cell.first < width && cell.second >= 0 && cell.second < height) {
+                int bit = cell.second * width + cell.first;
+                mask[bit >> 3] |= static_cast<uint8_t>(1 << (bit & 7));
             }
         }
-        return true;
+        pentomino_set_board(handle.get(), width, height, mask.data());
     }
-    
-    // Place piece on board
-    void place_piece(const std::vector<std::pair<int, int>>& orientation, 
-                    int start_x, int start_y, int piece_id) {
-        for (const auto& cell : orientation) {
-            int x = start_x + cell.first;
-            int y = start_y + cell.second;
-            board[y][x] = piece_id;
-        }
-    }
-    
-    // Remove piece from board
-    void remove_piece(const std::vector<std::pair<int, int>>& orientation, 
-                     int start_x, int start_y) {
-        for (const auto& cell : orientation) {
-            int x = start_x + cell.first;
-            int y = start_y + cell.second;
-            board[y][x] = -1;
-        }
+
+    // Same from a bitmask as in pentomino_set_board(), passed as a Uint8Array
+    void init_board_mask(int w, int h, const std::string& blocked) {
+        width = std::max(w, 0);
+        height = std::max(h, 0);
+        std::vector<uint8_t> mask((width * height + 7) / 8);
+        std::copy_n(blocked.begin(), std::min(blocked.size(), mask.size()), mask.begin());
+        pentomino_set_board(handle.get(), width, height, mask.data());
     }
-    
-    // Find first empty cell (for systematic placement)
-    std::pair<int, int> find_first_empty() {
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                if (board[y][x] == -1) {
-                    return {x, y};
-                }
-            }
-        }
-        return {-1, -1}; // No empty cells
+
+    void set_config(int max_sols, int max_time) {
+        pentomino_set_limits(handle.get(), std::max(max_sols, 0), std::max(max_time, 0));
     }
-    
-    // Backtracking solver
-    bool solve_recursive(int piece_index) {
-        // Check timeout
-        auto current_time = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            current_time - start_time).count();
-        
-        if (max_time_ms > 0 && elapsed > max_time_ms) {
-            should_stop = true;
-            return false;
-        }
-        
-        if (should_stop) return false;
-        
-        // Check solution limit
-        if (max_solutions > 0 && solutions_found >= max_solutions) {
-            should_stop = true;
-            return false;
-        }
-        
-        // Base case: all pieces placed
-        if (piece_index >= PENTOMINO_SHAPES.size()) {
-            solutions_found++;
-            return true;
-        }
-        
-        steps_explored++;
-        
-        // Find first empty cell for systematic placement
-        auto empty_cell = find_first_empty();
-        if (empty_cell.first == -1) {
-            return false; // No empty cells but pieces remaining
-        }
-        
-        // Try all orientations of current piece
-        for (const auto& orientation : all_orientations[piece_index]) {
-            // Try positions in a small area around the first empty cell
-            int search_radius = 2;
-            int start_x = std::max(0, empty_cell.first - search_radius);
-            int end_x = std::min(width, empty_cell.first + search_radius + 1);
-            int start_y = std::max(0, empty_cell.second - search_radius);
-            int end_y = std::min(height, empty_cell.second + search_radius + 1);
-            
-            for (int y = start_y; y < end_y; y++) {
-                for (int x = start_x; x < end_x; x++) {
-                    if (should_stop) return false;
-                    
-                    if (can_place_piece(orientation, x, y)) {
-                        place_piece(orientation, x, y, piece_index);
-                        
-                        if (solve_recursive(piece_index + 1)) {
-                            return true; // Found solution
-                        }
-                        
-                        remove_piece(orientation, x, y);
-                    }
-                }
-            }
-        }
-        
-        return false;
+
+    // Same with a node budget, 0 = unlimited (a double: JS numbers are exact to 2^53)
+    void set_config_nodes(int max_sols, int max_time, double max_nodes) {
+        set_config(max_sols, max_time);
+        pentomino_set_node_limit(handle.get(), static_cast<int64_t>(std::max(max_nodes, 0.0)));
     }
 
-public:
-    PentominoSolver() : solutions_found(0), max_solutions(1), steps_explored(0), 
-                       max_time_ms(30000), should_stop(false) {
-        // Generate all orientations for each piece
-        all_orientations.resize(PENTOMINO_SHAPES.size());
-        for (size_t i = 0; i < PENTOMINO_SHAPES.size(); i++) {
-            all_orientations[i] = generate_orientations(PENTOMINO_SHAPES[i]);
-        }
+    void set_deterministic(bool enabled) {
+        pentomino_set_deterministic(handle.get(), enabled);
     }
-    
-    // Initialize board
-    void init_board(int w, int h, const std::vector<std::pair<int, int>>& blocked_cells) {
-        width = w;
-        height = h;
-        board.assign(height, std::vector<int>(width, -1));
-        
-        // Mark blocked cells
-        for (const auto& cell : blocked_cells) {
-            if (cell.first >= 0 && cell.first < width && 
-                cell.second >= 0 && cell.second < height) {
-                board[cell.second][cell.first] = -2; // -2 for blocked
-            }
-        }
+
+    // Missing entries count as 0 and extra ones are ignored; empty restores whole sets
+    void set_piece_counts(const std::vector<int>& counts) {
+        if (counts.empty()) {
+            pentomino_set_piece_counts(handle.get(), nullptr);
+            return;
+        }
+        int32_t padded[PENTOMINO_PIECE_TYPES] = {};
+        for (size_t p = 0; p < counts.size() && p < PENTOMINO_PIECE_TYPES; p++) padded[p] = counts[p];
+        pentomino_set_piece_counts(handle.get(), padded);
     }
-    
-    // Set solver configuration
-    void set_config(int max_sols, int max_time) {
-        max_solutions = max_sols;
-        max_time_ms = max_time;
+
+    bool set_algorithm(const std::string& name) {
+        return pentomino_set_algorithm(handle.get(), name.c_str()) == PENTOMINO_OK;
     }
-    
-    // Solve the puzzle
+
     val solve() {
-        solutions_found = 0;
-        steps_explored = 0;
-        should_stop = false;
-        start_time = std::chrono::steady_clock::now();
-        
-        // Quick validation
-        int empty_cells = 0;
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                if (board[y][x] == -1) {
-                    empty_cells++;
-                }
-            }
-        }
-        
-        // Need exactly 60 cells for 12 pentomino pieces
-        if (empty_cells != 60) {
-            val result = val::object();
-            result.set("success", false);
-            result.set("solutions_found", 0);
-            result.set("steps_explored", 0);
-            result.set("solving_time", 0);
-            result.set("error", "Invalid board: need exactly 60 empty cells");
-            return result;
-        }
-        
-        bool found = solve_recursive(0);
-        
-        auto end_time = std::chrono::steady_clock::now();
-        auto solving_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-            end_time - start_time).count();
-        
+        pentomino_result solved;
+        int status = pentomino_solve(handle.get(), &solved);
+
         val result = val::object();
-        result.set("success", true);
-        result.set("solutions_found", solutions_found);
-        result.set("steps_explored", steps_explored);
-        result.set("solving_time", solving_time);
-        
-        if (should_stop && solving_time >= max_time_ms) {
+        result.set("success", status == PENTOMINO_OK && solved.success);
+        result.set("solutions_found", static_cast<int>(solved.solutions));
+        result.set("steps_explored", static_cast<double>(solved.nodes));
+        result.set("solving_time", static_cast<double>(solved.solving_ms));
+        result.set("engine", std::string(solved.engine));
+
+        if (status != PENTOMINO_OK) {
+            result.set("error", std::string(pentomino_last_error(handle.get())));
+        }
+        if (solved.timed_out == PENTOMINO_TIMED_OUT) {
             result.set("timeout", true);
+        } else if (solved.timed_out == PENTOMINO_NODE_LIMIT) {
+            result.set("node_limit", true);
         }
-        
+
         return result;
     }
-    
-    // Get current board state
+
     val get_board() {
+        std::vector<int32_t> cells(width * height);
+        if (pentomino_get_board(handle.get(), cells.data()) != PENTOMINO_OK) return val::array();
         val board_array = val::array();
         for (int y = 0; y < height; y++) {
             val row = val::array();
             for (int x = 0; x < width; x++) {
-                row.call<void>("push", board[y][x]);
+                row.call<void>("push", cells[y * width + x]);
             }
             board_array.call<void>("push", row);
         }
         return board_array;
     }
-    
-    // Stop solving
+
     void stop() {
-        should_stop = true;
+        pentomino_stop(handle.get());
     }
-    
-    // Get progress
+
     val get_progress() {
-        auto current_time = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            current_time - start_time).count();
-        
+        pentomino_progress current;
+        pentomino_get_progress(handle.get(), &current);
+
         val progress = val::object();
-        progress.set("steps_explored", steps_explored);
-        progress.set("solutions_found", solutions_found);
-        progress.set("time_elapsed", elapsed);
+        progress.set("steps_explored", static_cast<double>(current.nodes));
+        progress.set("solutions_found", static_cast<int>(current.solutions));
+        progress.set("time_elapsed", static_cast<double>(current.elapsed_ms));
         return progress;
     }
+
+private:
+    struct Destroy {
+        void operator()(pentomino_solver* solver) const { pentomino_destroy(solver); }
+    };
+
+    std::unique_ptr<pentomino_solver, Destroy> handle;
+    int width = 0;
+    int height = 0;
 };
 
+val board_to_js(const std::vector<std::vector<int>>& board) {
+    val board_array = val::array();
+    for (const auto& cells : board) {
+        val row = val::array();
+        for (int cell : cells) {
+            row.call<void>("push", cell);
+        }
+        board_array.call<void>("push", row);
+    }
+    return board_array;
+}
+
+// One result object per queued board, in queue order
+val solve_batch_to_js(BatchSolver& solver) {
+    val results = val::array();
+    for (const auto& entry : solver.solve()) {
+        val result = val::object();
+        result.set("success", entry.result.success);
+        result.set("solutions_found", entry.result.solutions_found);
+        result.set("steps_explored", static_cast<double>(entry.result.steps_explored));
+        result.set("solving_time", static_cast<double>(entry.result.solving_time));
+        result.set("engine", std::string(entry.result.engine));
+        if (!entry.result.error.empty()) {
+            result.set("error", entry.result.error);
+        }
+        if (entry.result.timeout) {
+            result.set("timeout", true);
+        }
+        result.set("board", board_to_js(entry.board));
+        results.call<void>("push", result);
+    }
+    return results;
+}
+
 // Emscripten bindings
 EMSCRIPTEN_BINDINGS(pentomino_solver) {
-    class_<PentominoSolver>("PentominoSolver")
+    class_<JsSolver>("PentominoSolver")
+        .constructor<>()
+        .function("init_board", &JsSolver::init_board)
+        .function("init_board_mask", &JsSolver::init_board_mask)
+        .function("set_config", &JsSolver::set_config)
+        .function("set_config", &JsSolver::set_config_nodes)
+        .function("set_deterministic", &JsSolver::set_deterministic)
+        .function("set_piece_counts", &JsSolver::set_piece_counts)
+        .function("set_algorithm", &JsSolver::set_algorithm)
+        .function("solve", &JsSolver::solve)
+        .function("get_board", &JsSolver::get_board)
+        .function("stop", &JsSolver::stop)
+        .function("get_progress", &JsSolver::get_progress);
+
+    class_<BatchSolver>("BatchSolver")
         .constructor<>()
-        .function("init_board", &PentominoSolver::init_board)
-        .function("set_config", &PentominoSolver::set_config)
-        .function("solve", &PentominoSolver::solve)
-        .function("get_board", &PentominoSolver::get_board)
-        .function("stop", &PentominoSolver::stop)
-        .function("get_progress", &PentominoSolver::get_progress);
-        
+        .function("add_board", &BatchSolver::add_board)
+        .function("clear", &BatchSolver::clear)
+        .function("size", &BatchSolver::size)
+        .function("set_config", &BatchSolver::set_config)
+        .function("solve", &solve_batch_to_js)
+        .function("stop", &BatchSolver::stop);
+
     register_vector<std::pair<int, int>>("VectorPairIntInt");
+    register_vector<int>("VectorInt");
 }
@@ -0,0 +1,744 @@
+#ifndef PENTOMINO_SOLVER_H
+#define PENTOMINO_SOLVER_H
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <cstring>
+#include <functional>
+#include "solver_common.h"
+#include "pieces.h"
+#include "arena.h"
+#include "bitboard.h"
+#include "dlx.h"
+#include "dancing_cells.h"
+#include "rowset_engine.h"
+#include "hybrid_engine.h"
+
+// Search algorithm, named as in the app's SolverConfig.algorithm
+enum class SolverAlgorithm {
+    BACKTRACKING,   // bitboard engine, grid search beyond 512 cells
+    DANCING_LINKS,  // DlxEngine where the piece set allows it
+    DANCING_CELLS,  // DancingCellsEngine where the piece set allows it
+    BIT_PARALLEL,   // RowsetEngine where the piece set and board size allow it
+    HYBRID,         // HybridEngine (DLX near the root, bitboard below) where the piece set allows it
+};
+
+inline const char* solver_algorithm_name(SolverAlgorithm algorithm) {
+    switch (algorithm) {
+        case SolverAlgorithm::DANCING_LINKS: return "dancing-links";
+        case SolverAlgorithm::DANCING_CELLS: return "dancing-cells";
+        case SolverAlgorithm::BIT_PARALLEL: return "bit-parallel";
+        case SolverAlgorithm::HYBRID: return "hybrid";
+        default: return "backtracking";
+    }
+}
+
+inline bool parse_solver_algorithm(const char* name, SolverAlgorithm& algorithm) {
+    const SolverAlgorithm all[] = {SolverAlgorithm::BACKTRACKING, SolverAlgorithm::DANCING_LINKS,
+                                   SolverAlgorithm::DANCING_CELLS, SolverAlgorithm::BIT_PARALLEL,
+                                   SolverAlgorithm::HYBRID};
+    for (SolverAlgorithm candidate : all) {
+        if (std::strcmp(name, solver_algorithm_name(candidate)) == 0) {
+            algorithm = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Outcome of PentominoSolver::solve()
+struct SolveResult {
+    bool success = false;
+    int solutions_found = 0;
+    long long steps_explored = 0;
+    long long solving_time = 0;
+    bool timeout = false;
+    bool node_limit = false;    // stopped at max_nodes (set_config with a node budget)
+    std::string error;
+    const char* engine = "";    // engine that ran: "bitboard", "grid", "dlx", "cells", "rowset" or "hybrid"
+};
+
+struct SolveProgress {
+    long long steps_explored = 0;
+    int solutions_found = 0;
+    long long time_elapsed = 0;
+};
+
+// Core solver, independent of the JavaScript bindings
+class PentominoSolver {
+private:
+    // Per-board data lives in the arena: the board from init_board() up to
+    // board_mark, then whatever the current solve builds, dropped by the next one
+    Arena arena;
+    Arena::Mark board_mark;
+    int* board;                       // width * height cells, row-major
+    OrientationTable all_orientations;
+    std::vector<int> piece_counts;    // explicit piece multiset, empty = whole sets
+    SolverAlgorithm algorithm;
+    int split_depth;                  // hybrid DLX levels, -1 = tuned per board
+    const char* engine;               // engine used by the last solve
+    int* piece_sequence;              // piece type per depth for the grid search
+    int total_pieces;
+    int width, height;
+    int solutions_found;
+    int max_solutions;
+    long long steps_explored;
+    std::chrono::steady_clock::time_point start_time;
+    int max_time_ms;
+    long long max_nodes;
+    bool deterministic;
+    std::atomic<bool> should_stop;
+    const std::atomic<bool>* cancel_flag;  // replaces should_stop when set
+    SharedLimit* shared_limit;             // solution budget shared with other searches
+    SolutionCallback on_solution;          // every solution, if set
+    SolutionCallback record_solution;      // engine callback: board copy, then on_solution
+    bool timed_out;
+    bool node_limit_reached;
+
+    // Solve in progress between start() and the step() that finishes it
+    SearchControl control;
+    std::array<int, PIECE_TYPES> solve_counts;
+    std::string solve_error;
+    bool search_started;
+    bool search_done;
+    long long solving_ms;
+    std::function<void()> resume_search;   // continues a paused resumable engine
+    std::function<long long(long long, const PrefixCallback&)> donate_search;  // donate() on it
+    std::function<int(uint8_t*)> path_search;  // solution_path() on it
+
+    // Subtree jobs, bitboard boards only
+    std::vector<PlacedPiece> prefix;       // pieces the search starts below
+    int expand_depth;                      // >= 0: report partial covers of this size instead
+    PrefixCallback on_prefix;
+    
+    // Grid search state. The grid is int8 occupancy (0 empty, 1 covered or
+    // blocked) with a GRID_PAD border of blocked sentinels, so placements near
+    // an edge need no bounds checks: any cell off the board reads as covered.
+    // Orientations are stored as five linear offsets from their origin.
+    static constexpr int SEARCH_RADIUS = 2;
+    static constexpr int GRID_PAD = SEARCH_RADIUS + PIECE_CELLS - 1;
+
+    struct GridMove {
+        int origin;        // grid index of the orientation origin
+        const int* cells;  // PIECE_CELLS offsets
+    };
+
+    int8_t* grid;
+    int grid_stride;
+    int grid_size;
+    int* orientation_offsets;         // PIECE_CELLS per orientation
+    int orientation_begin[PIECE_TYPES + 1];
+    GridMove* grid_moves;             // placement per depth
+
+    bool can_place_piece(const int* cells, int origin) const {
+        const int8_t* at = grid + origin;
+        return (at[cells[0]] | at[cells[1]] | at[cells[2]] | at[cells[3]] | at[cells[4]]) == 0;
+    }
+
+    void set_piece(const int* cells, int origin, int8_t value) {
+        int8_t* at = grid + origin;
+        for (int i = 0; i < PIECE_CELLS; i++) at[cells[i]] = value;
+    }
+
+    // First empty grid index in row-major order, or -1
+    int find_first_empty() const {
+        for (int i = 0; i < grid_size; i++) {
+            if (grid[i] == 0) return i;
+        }
+        return -1;
+    }
+
+    // Backtracking solver
+    bool solve_recursive(int piece_index) {
+        // Check timeout
+        if (max_time_ms > 0 && !deterministic) {
+            auto current_time = std::chrono::steady_clock::now();
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                current_time - start_time).count();
+            if (elapsed > max_time_ms) {
+                should_stop = true;
+                timed_out = true;
+                return false;
+            }
+        }
+        
+        if (stop_requested()) return false;
+        
+        // Check solution limit
+        if (max_solutions > 0 && solutions_found >= max_solutions) {
+            should_stop = true;
+            return false;
+        }
+        
+        // Base case: all pieces placed
+        if (piece_index >= total_pieces) {
+            solutions_found++;
+            return true;
+        }
+        
+        steps_explored++;
+        if (max_nodes > 0 && steps_explored > max_nodes) {
+            steps_explored = max_nodes;
+            should_stop = true;
+            node_limit_reached = true;
+            return false;
+        }
+        
+        // Find first empty cell for systematic placement
+        int empty_cell = find_first_empty();
+        if (empty_cell == -1) {
+            return false; // No empty cells but pieces remaining
+        }
+        
+        // Try all orientations of current piece
+        int piece = piece_sequence[piece_index];
+        for (int o = orientation_begin[piece]; o < orientation_begin[piece + 1]; o++) {
+            const int* cells = orientation_offsets + o * PIECE_CELLS;
+
+            // Try origins in a small area around the first empty cell; the
+            // padding keeps every origin and cell of this window inside the grid
+            for (int dy = -SEARCH_RADIUS; dy <= SEARCH_RADIUS; dy++) {
+                int row = empty_cell + dy * grid_stride;
+                for (int dx = -SEARCH_RADIUS; dx <= SEARCH_RADIUS; dx++) {
+                    if (stop_requested()) return false;
+                    
+                    int origin = row + dx;
+                    if (can_place_piece(cells, origin)) {
+                        set_piece(cells, origin, 1);
+                        grid_moves[piece_index] = {origin, cells};
+                        
+                        if (solve_recursive(piece_index + 1)) {
+                            return true; // Found solution
+                        }
+                        
+                        set_piece(cells, origin, 0);
+                    }
+                }
+            }
+        }
+        
+        return false;
+    }
+
+    // Work out how many copies of each piece the board needs. Without an explicit
+    // multiset the board is filled with whole sets (60 cells per set).
+    bool resolve_piece_counts(int empty_cells, std::array<int, PIECE_TYPES>& counts,
+                              std::string& error) {
+        if (!piece_counts.empty()) {
+            int total = 0;
+            for (int p = 0; p < PIECE_TYPES; p++) {
+                counts[p] = p < static_cast<int>(piece_counts.size()) ? std::max(0, piece_counts[p]) : 0;
+                total += counts[p];
+            }
+            if (empty_cells != total * PIECE_CELLS) {
+                error = "Invalid board: need exactly " + std::to_string(total * PIECE_CELLS) +
+                        " empty cells for the selected pieces";
+                return false;
+            }
+            return true;
+        }
+
+        int cells_per_set = PIECE_TYPES * PIECE_CELLS;
+        if (empty_cells == 0 || empty_cells % cells_per_set != 0) {
+            error = empty_cells < cells_per_set
+                ? "Invalid board: need exactly 60 empty cells"
+                : "Invalid board: need a multiple of 60 empty cells";
+            return false;
+        }
+        counts.fill(empty_cells / cells_per_set);
+        return true;
+    }
+
+    const uint8_t* open_cells() {
+        uint8_t* open = arena.allocate<uint8_t>(width * height);
+        for (int i = 0; i < width * height; i++) {
+            open[i] = board[i] == -1;
+        }
+        return open;
+    }
+
+    // Copy a solution onto the board. Copies of the same piece type get
+    // distinct ids (type + 12 * copy) so they stay distinguishable.
+    void write_solution(const PlacedPiece* solution, int count) {
+        std::array<int, PIECE_TYPES> copies{};
+        for (int i = 0; i < count; i++) {
+            const PlacedPiece& placed = solution[i];
+            int id = placed.piece + PIECE_TYPES * copies[placed.piece]++;
+            for (int cell : placed.cells) {
+                board[cell] = id;
+            }
+        }
+    }
+
+    // Run the bitboard engine sized for the board; false if no bitboard fits
+    bool solve_bitboard(const std::array<int, PIECE_TYPES>& counts) {
+        int cells = width * height;
+        if (cells <= 64) return run_bitboard<1>(counts);
+        if (cells <= 128) return run_bitboard<2>(counts);
+        if (cells <= 192) return run_bitboard<3>(counts);
+        if (cells <= 256) return run_bitboard<4>(counts);
+        if (cells <= 512) return run_bitboard<8>(counts);
+        return false;
+    }
+
+    // The bitboard engine is the resumable one: it lives in the arena rather
+    // than on the stack, so a search paused at a node budget outlives the call
+    template <int Words>
+    bool run_bitboard(const std::array<int, PIECE_TYPES>& counts) {
+        auto* bitboard = new (arena.allocate<BitboardEngine<Words>>(1)) BitboardEngine<Words>();
+        if (!bitboard->setup(width, height, open_cells(), all_orientations, counts, arena)) {
+            return false;
+        }
+        engine = "bitboard";
+        if (!bitboard->begin_residual(prefix.data(), static_cast<int>(prefix.size()))) return true;
+        if (expand_depth >= 0) {
+            std::vector<uint8_t> path;
+            bitboard->expand(expand_depth, control, [&](const PlacedPiece* pieces, int count) {
+                int levels = count - static_cast<int>(prefix.size());
+                path.resize(levels);
+                for (int level = 0; level < levels; level++) path[level] = static_cast<uint8_t>(bitboard->branch(level));
+                if (on_prefix) on_prefix(pieces, count, path.data(), levels);
+            });
+            collect_counters();
+            return true;
+        }
+        resume_search = [this, bitboard] {
+            bitboard->resume(control, record_solution);
+            collect_counters();
+        };
+        donate_search = [this, bitboard](long long min_nodes, const PrefixCallback& on_job) -> long long {
+            int level, tried, untried;
+            if (bitboard->finished() || !bitboard->untried_level(level, tried, untried)) return 0;
+            long long estimate = (control.nodes - bitboard->opened_at(level)) / (tried > 0 ? tried : 1);
+            if (estimate < min_nodes) return 0;
+            std::vector<uint8_t> path(level + 1);
+            for (int l = 0; l < level; l++) path[l] = static_cast<uint8_t>(bitboard->branch(l));
+            bitboard->donate(level, (untried + 1) / 2, [&](const PlacedPiece* pieces, int count, int index) {
+                path[level] = static_cast<uint8_t>(index);
+                on_job(pieces, count, path.data(), level + 1);
+            });
+            return estimate;
+        };
+        path_search = [this, bitboard](uint8_t* path) {
+            for (int level = 0; level < bitboard->levels(); level++) path[level] = static_cast<uint8_t>(bitboard->branch(level));
+            return bitboard->levels();
+        };
+        resume_search();
+        return true;
+    }
+
+    bool solve_hybrid(const std::array<int, PIECE_TYPES>& counts) {
+        int cells = width * height;
+        if (cells <= 64) return run_hybrid<1>(counts);
+        if (cells <= 128) return run_hybrid<2>(counts);
+        if (cells <= 192) return run_hybrid<3>(counts);
+        if (cells <= 256) return run_hybrid<4>(counts);
+        if (cells <= 512) return run_hybrid<8>(counts);
+        return false;
+    }
+
+    template <int Words>
+    bool run_hybrid(const std::array<int, PIECE_TYPES>& counts) {
+        HybridEngine<Words> hybrid;
+        hybrid.set_split_depth(split_depth);
+        if (!hybrid.setup(width, height, open_cells(), all_orientations, counts, arena)) {
+            return false;
+        }
+        engine = "hybrid";
+        run_engine(hybrid);
+        return true;
+    }
+
+    // Run an exact cover engine; false if it cannot take this piece set
+    template <typename Engine>
+    bool solve_exact_cover(const std::array<int, PIECE_TYPES>& counts, const char* name) {
+        Engine cover;
+        if (!cover.setup(width, height, open_cells(), all_orientations, counts, arena)) {
+            return false;
+        }
+        engine = name;
+        run_engine(cover);
+        return true;
+    }
+
+    // Search with a set-up engine to the end, keeping the first solution on the board
+    template <typename Engine>
+    void run_engine(Engine& search) {
+        search.solve(control, record_solution);
+        collect_counters();
+    }
+
+    void collect_counters() {
+        steps_explored = control.nodes;
+        solutions_found = control.solutions;
+        timed_out = control.timed_out;
+        node_limit_reached = control.node_limit_reached;
+    }
+
+    // Pick the engine for the board and run it (up to the node budget, if it
+    // is the bitboard): an exact cover engine if selected and the board allows
+    // it, otherwise bitboards up to 512 cells and the grid search beyond
+    void run_search() {
+        if (!prefix.empty() || expand_depth >= 0) {
+            if (!solve_bitboard(solve_counts)) solve_error = "Subtree jobs need a board of at most 512 cells";
+            return;
+        }
+        bool solved = false;
+        if (algorithm == SolverAlgorithm::DANCING_LINKS) {
+            solved = solve_exact_cover<DlxEngine>(solve_counts, "dlx");
+        } else if (algorithm == SolverAlgorithm::DANCING_CELLS) {
+            solved = solve_exact_cover<DancingCellsEngine>(solve_counts, "cells");
+        } else if (algorithm == SolverAlgorithm::BIT_PARALLEL) {
+            solved = solve_exact_cover<RowsetEngine>(solve_counts, "rowset");
+        } else if (algorithm == SolverAlgorithm::HYBRID) {
+            solved = solve_hybrid(solve_counts);
+        }
+        if (!solved && !solve_bitboard(solve_counts)) {
+            solve_grid(solve_counts);
+        }
+    }
+
+    void build_grid() {
+        grid_stride = width + 2 * GRID_PAD;
+        grid_size = grid_stride * (height + 2 * GRID_PAD);
+        grid = arena.allocate_filled<int8_t>(grid_size, 1);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                grid[(y + GRID_PAD) * grid_stride + x + GRID_PAD] = board[y * width + x] != -1;
+            }
+        }
+
+        int total = 0;
+        for (int p = 0; p < PIECE_TYPES; p++) total += static_cast<int>(all_orientations[p].size());
+        orientation_offsets = arena.allocate<int>(total * PIECE_CELLS);
+        int o = 0;
+        for (int p = 0; p < PIECE_TYPES; p++) {
+            orientation_begin[p] = o;
+            for (const auto& orientation : all_orientations[p]) {
+                for (int i = 0; i < PIECE_CELLS; i++) {
+                    orientation_offsets[o * PIECE_CELLS + i] =
+                        orientation[i].second * grid_stride + orientation[i].first;
+                }
+                o++;
+            }
+        }
+        orientation_begin[PIECE_TYPES] = o;
+    }
+
+    // Grid backtracking fallback for boards too large for any bitboard
+    void solve_grid(const std::array<int, PIECE_TYPES>& counts) {
+        total_pieces = 0;
+        for (int c : counts) total_pieces += c;
+        piece_sequence = arena.allocate<int>(total_pieces);
+        grid_moves = arena.allocate<GridMove>(total_pieces);
+        int depth = 0;
+        for (int p = 0; p < PIECE_TYPES; p++) {
+            for (int copy = 0; copy < counts[p]; copy++) {
+                piece_sequence[depth++] = p;
+            }
+        }
+        build_grid();
+        engine = "grid";
+        if (!solve_recursive(0)) return;
+
+        PlacedPiece* solution = arena.allocate<PlacedPiece>(total_pieces);
+        for (int d = 0; d < total_pieces; d++) {
+            solution[d].piece = piece_sequence[d];
+            for (int i = 0; i < PIECE_CELLS; i++) {
+                int cell = grid_moves[d].origin + grid_moves[d].cells[i];
+                solution[d].cells[i] = (cell / grid_stride - GRID_PAD) * width + cell % grid_stride - GRID_PAD;
+            }
+        }
+        write_solution(solution, total_pieces);
+        if (on_solution) on_solution(solution, total_pieces);
+    }
+
+    bool stop_requested() const {
+        return should_stop || (cancel_flag && cancel_flag->load(std::memory_order_relaxed));
+    }
+
+public:
+    PentominoSolver() : board_mark(arena.mark()), board(nullptr), algorithm(SolverAlgorithm::BACKTRACKING),
+                       split_depth(-1), engine(""), piece_sequence(nullptr),
+                       total_pieces(0), width(0), height(0), solutions_found(0), max_solutions(1),
+                       steps_explored(0), max_time_ms(30000), max_nodes(0), deterministic(false), should_stop(false),
+                       cancel_flag(nullptr), shared_limit(nullptr), timed_out(false), node_limit_reached(false),
+                       solve_counts{}, search_started(false), search_done(true),
+                       solving_ms(0), expand_depth(-1),
+                       grid(nullptr), grid_stride(0), grid_size(0), orientation_offsets(nullptr),
+                       orientation_begin{}, grid_moves(nullptr) {
+        // Generate all orientations for each piece
+        all_orientations = build_orientation_table();
+        record_solution = [this](const PlacedPiece* solution, int count) {
+            if (control.solutions == 1) write_solution(solution, count);
+            if (on_solution) on_solution(solution, count);
+        };
+    }
+    
+    // Initialize board
+    void init_board(int w, int h, const std::vector<std::pair<int, int>>& blocked_cells) {
+        width = w;
+        height = h;
+        arena.reset();
+        board = arena.allocate_filled<int>(width * height, -1);
+        board_mark = arena.mark();
+        
+        // Mark blocked cells
+        for (const auto& cell : blocked_cells) {
+            if (cell.first >= 0 && cell.first < width && 
+                cell.second >= 0 && cell.second < height) {
+                board[cell.second * width + cell.first] = -2; // -2 for blocked
+            }
+        }
+    }
+    
+    // Set solver configuration
+    void set_config(int max_sols, int max_time) {
+        max_solutions = max_sols;
+        max_time_ms = max_time;
+    }
+
+    // Same with a node budget for the whole search (0 = unlimited): it stops
+    // after exactly max_nodes nodes with result().node_limit set. Unlike a
+    // time limit this stops at the same node on every machine.
+    void set_config(int max_sols, int max_time, long long max_node_count) {
+        set_config(max_sols, max_time);
+        max_nodes = max_node_count;
+    }
+
+    // Deterministic mode: no wall-clock checks during the search, so the time
+    // limit is ignored and a search explores the same nodes on every run and
+    // machine; bound it with a node budget instead. solving_time is still
+    // measured, after the search.
+    void set_deterministic(bool enabled) {
+        deterministic = enabled;
+    }
+
+    // Select the piece multiset: counts[i] copies of piece type i.
+    // An empty vector restores the default of whole sets.
+    void set_piece_counts(const std::vector<int>& counts) {
+        piece_counts = counts;
+    }
+
+    // Select the search algorithm by name; false (and no change) if unknown.
+    // Boards an algorithm cannot handle are solved with backtracking.
+    bool set_algorithm(const std::string& name) {
+        return parse_solver_algorithm(name.c_str(), algorithm);
+    }
+
+    // Dancing links levels of the hybrid algorithm; -1 picks them per board
+    void set_split_depth(int depth) {
+        split_depth = depth;
+    }
+
+    // Stop flag owned by the caller, e.g. a service cancelling by request id
+    // from another thread. Unlike stop(), a flag set before solve() starts is
+    // not cleared by it. nullptr restores the solver's own flag.
+    void set_cancel_flag(const std::atomic<bool>* flag) {
+        cancel_flag = flag;
+    }
+
+    // Solution budget shared with searches on other threads (solver_common.h);
+    // max_solutions still applies to this search on its own. Pair it with
+    // set_cancel_flag(&limit->stop) so this search stops when another one
+    // takes the last solution. nullptr turns it off.
+    void set_shared_limit(SharedLimit* limit) {
+        shared_limit = limit;
+    }
+
+    // Called with every solution found (the board only keeps the first);
+    // the pieces are only valid during the call
+    void set_solution_callback(SolutionCallback callback) {
+        on_solution = std::move(callback);
+    }
+    
+    // Search only below these pieces (from this board's piece set, e.g. a
+    // subtree job from expand_jobs()); solutions still list every piece.
+    // Runs on the bitboard engine whatever the algorithm. Empty = whole board.
+    void set_prefix(const std::vector<PlacedPiece>& pieces) {
+        prefix = pieces;
+    }
+
+    // Split the search into subtree jobs: run it down to `depth` placed
+    // pieces (below the prefix, if one is set) and pass every partial cover
+    // that is not pruned to on_job, in search order. Solving each job with
+    // set_prefix() covers the whole search exactly once. depth is capped one
+    // below the number of pieces to place. The result counts the nodes above
+    // the jobs; its success is false with an error if the board is invalid
+    // or too large for the bitboard engine.
+    SolveResult expand_jobs(int depth, const PrefixCallback& on_job) {
+        expand_depth = depth;
+        on_prefix = on_job;
+        SolveResult expanded = solve();
+        expand_depth = -1;
+        on_prefix = nullptr;
+        return expanded;
+    }
+
+    // Solve the puzzle
+    SolveResult solve() {
+        if (start()) {
+            while (!step(0)) {}
+        }
+        return result();
+    }
+
+    // Solve in slices, for schedulers that share threads between searches:
+    // start() checks the board, then each step() searches until about
+    // node_budget more nodes (0 = no budget) and returns true once the search
+    // is over; result() reports it as solve() would. Only the bitboard engine
+    // pauses at the budget, every other engine finishes in its first step.
+    // Time limits count from start(), paused time included. The solver must
+    // not be reconfigured between start() and the last step().
+    bool start() {
+        solutions_found = 0;
+        steps_explored = 0;
+        should_stop = false;
+        timed_out = false;
+        node_limit_reached = false;
+        engine = "";
+        solve_error.clear();
+        resume_search = nullptr;
+        donate_search = nullptr;
+        path_search = nullptr;
+        search_started = false;
+        search_done = true;
+        solving_ms = 0;
+        start_time = std::chrono::steady_clock::now();
+        arena.rewind(board_mark);
+        
+        // Quick validation
+        int empty_cells = 0;
+        for (int i = 0; i < width * height; i++) {
+            if (board[i] == -1) {
+                empty_cells++;
+            }
+        }
+        
+        // Every piece covers 5 cells, so the empty cells must match the piece multiset
+        if (!resolve_piece_counts(empty_cells, solve_counts, solve_error)) {
+            return false;
+        }
+
+        control = SearchControl();
+        control.max_solutions = max_solutions;
+        control.max_time_ms = max_time_ms;
+        control.max_nodes = max_nodes;
+        control.deterministic = deterministic;
+        control.stop_flag = cancel_flag ? cancel_flag : &should_stop;
+        control.shared_limit = shared_limit;
+        control.start_time = start_time;
+        search_done = false;
+        return true;
+    }
+
+    bool step(long long node_budget) {
+        if (search_done) return true;
+        control.pause_at = node_budget > 0 ? control.nodes + node_budget : 0;
+        control.paused = false;
+        if (!search_started) {
+            search_started = true;
+            run_search();
+        } else if (resume_search) {
+            resume_search();
+        }
+        if (!control.paused) {
+            search_done = true;
+            resume_search = nullptr;
+            donate_search = nullptr;
+            path_search = nullptr;
+            solving_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time).count();
+        }
+        return search_done;
+    }
+
+    // Split work off a search paused by step(), for load balancing: the later
+    // half of the untried alternatives at the shallowest level that has any
+    // go to on_job as subtree jobs (path relative to the prefix) and are
+    // dropped from this search. Their size is estimated from the siblings
+    // already searched there, as nodes below that level per alternative
+    // taken; nothing is given away when that is below min_nodes. Returns the
+    // estimate per job, 0 when nothing was donated (also for engines that
+    // cannot pause).
+    long long donate(long long min_nodes, const PrefixCallback& on_job) {
+        return !search_done && donate_search ? donate_search(min_nodes, on_job) : 0;
+    }
+
+    // Inside a solution callback of a resumable search: the candidate index
+    // taken at each level below the prefix, into path (room for one per
+    // piece). Solutions sort into the order of the sequential search by
+    // prefix path, then this. Returns the number of levels, 0 for engines
+    // that do not track them.
+    int solution_path(uint8_t* path) const {
+        return path_search ? path_search(path) : 0;
+    }
+
+    SolveResult result() const {
+        SolveResult result;
+        if (!solve_error.empty()) {
+            result.error = solve_error;
+            return result;
+        }
+        result.success = true;
+        result.solutions_found = solutions_found;
+        result.steps_explored = steps_explored;
+        result.solving_time = solving_ms;
+        result.timeout = timed_out;
+        result.node_limit = node_limit_reached;
+        result.engine = engine;
+        return result;
+    }
+    
+    // Get current board state (-1 empty, -2 blocked, otherwise piece id)
+    std::vector<std::vector<int>> get_board() const {
+        std::vector<std::vector<int>> rows(height, std::vector<int>(width));
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                rows[y][x] = board[y * width + x];
+            }
+        }
+        return rows;
+    }
+
+    // Same, without copying: width * height cells, row-major
+    const int* get_cells() const {
+        return board;
+    }
+
+    int get_width() const {
+        return width;
+    }
+
+    int get_height() const {
+        return height;
+    }
+
+    // Heap memory held by the solver's arena
+    size_t arena_capacity() const {
+        return arena.capacity();
+    }
+    
+    // Stop solving
+    void stop() {
+        should_stop = true;
+    }
+    
+    // Get progress
+    SolveProgress get_progress() const {
+        auto current_time = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            current_time - start_time).count();
+        
+        SolveProgress progress;
+        progress.steps_explored = steps_explored;
+        progress.solutions_found = solutions_found;
+        progress.time_elapsed = elapsed;
+        return progress;
+    }
+};
+
+#endif // PENTOMINO_SOLVER_H
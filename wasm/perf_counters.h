@@ -0,0 +1,149 @@
+#ifndef PENTOMINO_PERF_COUNTERS_H
+#define PENTOMINO_PERF_COUNTERS_H
+
+// Hardware event counters for the native benchmark, read through Linux
+// perf_event_open. Counting is limited to this process in user space. Where
+// the kernel refuses (other platforms, perf_event_paranoid, VMs without a
+// PMU) the counter reports itself unavailable and the benchmark prints n/a.
+// When more events are open than the PMU has counters, the kernel time-shares
+// them; values are scaled up by enabled / running time to compensate.
+
+#include <cstdint>
+#include <memory>
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PENTOMINO_HAVE_PERF_EVENTS 1
+#endif
+
+enum class PerfEvent {
+    CYCLES,         // core cycles
+    INSTRUCTIONS,   // instructions retired
+    L1D_MISSES,     // L1 data cache read misses
+    CACHE_MISSES,   // last-level cache misses
+    BRANCH_MISSES,  // mispredicted branches
+};
+
+constexpr int PERF_EVENT_COUNT = 5;
+
+class PerfCounter {
+public:
+    explicit PerfCounter(PerfEvent event) {
+#ifdef PENTOMINO_HAVE_PERF_EVENTS
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        switch (event) {
+            case PerfEvent::CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+            case PerfEvent::INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+            case PerfEvent::L1D_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case PerfEvent::CACHE_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+            case PerfEvent::BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        }
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)event;
+#endif
+    }
+
+    ~PerfCounter() {
+#ifdef PENTOMINO_HAVE_PERF_EVENTS
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    bool available() const {
+        return fd_ >= 0;
+    }
+
+    void start() {
+#ifdef PENTOMINO_HAVE_PERF_EVENTS
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Events since start(), scaled if the counter was multiplexed; 0 when
+    // unavailable or never scheduled
+    uint64_t stop() {
+        uint64_t value = 0;
+#ifdef PENTOMINO_HAVE_PERF_EVENTS
+        if (fd_ < 0) return 0;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t data[3];  // value, time enabled, time running
+        if (read(fd_, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) return 0;
+        value = data[0];
+        if (data[2] < data[1]) {
+            value = static_cast<uint64_t>(static_cast<double>(value) * data[1] / data[2]);
+        }
+#endif
+        return value;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+// Counts of every PerfEvent over one measured region
+struct PerfSample {
+    uint64_t values[PERF_EVENT_COUNT] = {};
+
+    uint64_t operator[](PerfEvent event) const {
+        return values[static_cast<int>(event)];
+    }
+};
+
+// One counter per PerfEvent, started and stopped together. Each event is
+// available or not on its own: a PMU may count cycles but not cache misses.
+class PerfCounterSet {
+public:
+    PerfCounterSet() {
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            counters_[e] = std::make_unique<PerfCounter>(static_cast<PerfEvent>(e));
+        }
+    }
+
+    bool available(PerfEvent event) const {
+        return counters_[static_cast<int>(event)]->available();
+    }
+
+    bool any_available() const {
+        for (const auto& counter : counters_) {
+            if (counter->available()) return true;
+        }
+        return false;
+    }
+
+    void start() {
+        for (auto& counter : counters_) counter->start();
+    }
+
+    // In reverse order of start(): each counter's region encloses the next one's
+    PerfSample stop() {
+        PerfSample sample;
+        for (int e = PERF_EVENT_COUNT - 1; e >= 0; e--) sample.values[e] = counters_[e]->stop();
+        return sample;
+    }
+
+private:
+    std::unique_ptr<PerfCounter> counters_[PERF_EVENT_COUNT];
+};
+
+#endif // PENTOMINO_PERF_COUNTERS_H
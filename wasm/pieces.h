@@ -0,0 +1,147 @@
+#ifndef PENTOMINO_PIECES_H
+#define PENTOMINO_PIECES_H
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include "solver_common.h"
+
+// Pentomino piece definitions (relative coordinates)
+inline const std::vector<std::vector<std::pair<int, int>>> PENTOMINO_SHAPES = {
+    // I piece
+    {{0,0}, {0,1}, {0,2}, {0,3}, {0,4}},
+    // L piece  
+    {{0,0}, {0,1}, {0,2}, {0,3}, {1,3}},
+    // N piece
+    {{0,0}, {0,1}, {1,1}, {1,2}, {1,3}},
+    // P piece
+    {{0,0}, {0,1}, {1,0}, {1,1}, {1,2}},
+    // Y piece
+    {{1,0}, {0,1}, {1,1}, {1,2}, {1,3}},
+    // T piece
+    {{0,0}, {1,0}, {2,0}, {1,1}, {1,2}},
+    // U piece
+    {{0,0}, {0,1}, {1,1}, {2,1}, {2,0}},
+    // V piece
+    {{0,0}, {0,1}, {0,2}, {1,2}, {2,2}},
+    // W piece
+    {{0,0}, {0,1}, {1,1}, {1,2}, {2,2}},
+    // X piece
+    {{1,0}, {0,1}, {1,1}, {2,1}, {1,2}},
+    // Z piece
+    {{0,0}, {1,0}, {1,1}, {1,2}, {2,2}},
+    // F piece
+    {{1,0}, {2,0}, {0,1}, {1,1}, {1,2}}
+};
+
+// Normalize shape to have minimum coordinates at origin
+inline void normalize_shape(std::vector<std::pair<int, int>>& shape) {
+    if (shape.empty()) return;
+    
+    int min_x = shape[0].first;
+    int min_y = shape[0].second;
+    
+    for (const auto& cell : shape) {
+        min_x = std::min(min_x, cell.first);
+        min_y = std::min(min_y, cell.second);
+    }
+    
+    for (auto& cell : shape) {
+        cell.first -= min_x;
+        cell.second -= min_y;
+    }
+    
+    // Sort for consistent comparison
+    std::sort(shape.begin(), shape.end());
+}
+
+// Generate all rotations and reflections of a piece
+inline std::vector<std::vector<std::pair<int, int>>> generate_orientations(
+    const std::vector<std::pair<int, int>>& shape) {
+    
+    std::vector<std::vector<std::pair<int, int>>> orientations;
+    std::vector<std::pair<int, int>> current = shape;
+    
+    // Generate 4 rotations
+    for (int rot = 0; rot < 4; rot++) {
+        // Normalize to origin
+        normalize_shape(current);
+        
+        // Add if not already present
+        if (std::find(orientations.begin(), orientations.end(), current) == orientations.end()) {
+            orientations.push_back(current);
+        }
+        
+        // Rotate 90 degrees clockwise: (x,y) -> (y,-x)
+        for (auto& cell : current) {
+            int new_x = cell.second;
+            int new_y = -cell.first;
+            cell.first = new_x;
+            cell.second = new_y;
+        }
+    }
+    
+    // Generate reflections
+    current = shape;
+    // Reflect horizontally: (x,y) -> (-x,y)
+    for (auto& cell : current) {
+        cell.first = -cell.first;
+    }
+    
+    // Generate 4 rotations of reflection
+    for (int rot = 0; rot < 4; rot++) {
+        normalize_shape(current);
+        
+        if (std::find(orientations.begin(), orientations.end(), current) == orientations.end()) {
+            orientations.push_back(current);
+        }
+        
+        for (auto& cell : current) {
+            int new_x = cell.second;
+            int new_y = -cell.first;
+            cell.first = new_x;
+            cell.second = new_y;
+        }
+    }
+    
+    return orientations;
+}
+
+// Orientation table for all twelve pieces, indexed by piece type
+inline OrientationTable build_orientation_table() {
+    OrientationTable table(PENTOMINO_SHAPES.size());
+    for (size_t i = 0; i < PENTOMINO_SHAPES.size(); i++) {
+        table[i] = generate_orientations(PENTOMINO_SHAPES[i]);
+    }
+    return table;
+}
+
+// visit(piece, cells) for every placement of the pieces with counts[piece] > 0
+// on the open cells of a width x height board, in piece/orientation/position
+// order; cells are linear (y * width + x)
+template <typename Visit>
+void for_each_board_placement(int width, int height, const uint8_t* open,
+                              const OrientationTable& orientations,
+                              const std::array<int, PIECE_TYPES>& counts, Visit&& visit) {
+    for (int piece = 0; piece < PIECE_TYPES; piece++) {
+        if (counts[piece] == 0) continue;
+        for (const auto& orientation : orientations[piece]) {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    int cells[PIECE_CELLS];
+                    bool fits = true;
+                    for (int i = 0; i < PIECE_CELLS && fits; i++) {
+                        int cx = x + orientation[i].first;
+                        int cy = y + orientation[i].second;
+                        fits = cx < width && cy < height && open[cy * width + cx];
+                        cells[i] = cy * width + cx;
+                    }
+                    if (fits) visit(piece, cells);
+                }
+            }
+        }
+    }
+}
+
+#endif // PENTOMINO_PIECES_H
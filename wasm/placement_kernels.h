@@ -0,0 +1,162 @@
+#ifndef PENTOMINO_PLACEMENT_KERNELS_H
+#define PENTOMINO_PLACEMENT_KERNELS_H
+
+#include <cstdint>
+#include "cpu_features.h"
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+// Batch placement legality kernels. Each kernel tests the n candidates of one
+// anchor block against the occupancy window and writes the indices (base + i)
+// of the legal ones to out: no overlap with occupied cells and piece still
+// available. Masks are word-major: word k of candidate i is masks[k * n + i].
+
+// Scalar test of candidates [first, n) of a block, appending to the count legal
+// entries already in out; also finishes the tails of the vector kernels
+template <int Span>
+inline int filter_placements_tail(const uint64_t* masks, const uint8_t* pieces, int n, int first,
+                                  const uint64_t* window, uint32_t available,
+                                  int base, uint16_t* out, int count) {
+    for (int i = first; i < n; i++) {
+        uint64_t hit = 0;
+        for (int k = 0; k < Span; k++) {
+            hit |= masks[k * n + i] & window[k];
+        }
+        out[count] = static_cast<uint16_t>(base + i);
+        count += (hit == 0) & ((available >> pieces[i]) & 1);
+    }
+    return count;
+}
+
+template <int Span>
+inline int filter_placements_scalar(const uint64_t* masks, const uint8_t* pieces, int n,
+                                    const uint64_t* window, uint32_t available,
+                                    int base, uint16_t* out) {
+    return filter_placements_tail<Span>(masks, pieces, n, 0, window, available, base, out, 0);
+}
+
+#ifdef __wasm_simd128__
+// Two candidates per v128 lane pair, four per iteration; the tail goes scalar
+template <int Span>
+inline int filter_placements_simd128(const uint64_t* masks, const uint8_t* pieces, int n,
+                                     const uint64_t* window, uint32_t available,
+                                     int base, uint16_t* out) {
+    v128_t occupied[Span];
+    for (int k = 0; k < Span; k++) occupied[k] = wasm_i64x2_splat(static_cast<int64_t>(window[k]));
+    const v128_t zero = wasm_i64x2_const(0, 0);
+
+    int count = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t hit_lo = zero;
+        v128_t hit_hi = zero;
+        for (int k = 0; k < Span; k++) {
+            const uint64_t* row = masks + k * n + i;
+            hit_lo = wasm_v128_or(hit_lo, wasm_v128_and(wasm_v128_load(row), occupied[k]));
+            hit_hi = wasm_v128_or(hit_hi, wasm_v128_and(wasm_v128_load(row + 2), occupied[k]));
+        }
+        uint32_t free_lanes = wasm_i64x2_bitmask(wasm_i64x2_eq(hit_lo, zero)) |
+                              (wasm_i64x2_bitmask(wasm_i64x2_eq(hit_hi, zero)) << 2);
+        for (int lane = 0; lane < 4; lane++) {
+            out[count] = static_cast<uint16_t>(base + i + lane);
+            count += ((free_lanes >> lane) & 1) & ((available >> pieces[i + lane]) & 1);
+        }
+    }
+    return filter_placements_tail<Span>(masks, pieces, n, i, window, available, base, out, count);
+}
+#endif
+
+#ifdef PENTOMINO_X86_KERNELS
+// Four candidates per 256-bit vector. Piece availability is tested in-vector by
+// shifting the availability mask by each candidate's piece index.
+template <int Span>
+PENTOMINO_TARGET_AVX2
+int filter_placements_avx2(const uint64_t* masks, const uint8_t* pieces, int n,
+                           const uint64_t* window, uint32_t available,
+                           int base, uint16_t* out) {
+    __m256i occupied[Span];
+    for (int k = 0; k < Span; k++) occupied[k] = _mm256_set1_epi64x(static_cast<long long>(window[k]));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i avail = _mm256_set1_epi64x(available);
+
+    int count = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i hit = zero;
+        for (int k = 0; k < Span; k++) {
+            __m256i cand = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + k * n + i));
+            hit = _mm256_or_si256(hit, _mm256_and_si256(cand, occupied[k]));
+        }
+        uint32_t piece_bytes;
+        __builtin_memcpy(&piece_bytes, pieces + i, sizeof(piece_bytes));
+        __m256i piece_index = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(piece_bytes)));
+        __m256i piece_free = _mm256_and_si256(_mm256_srlv_epi64(avail, piece_index), one);
+
+        __m256i legal = _mm256_and_si256(_mm256_cmpeq_epi64(hit, zero),
+                                         _mm256_cmpeq_epi64(piece_free, one));
+        uint32_t lanes = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(legal)));
+        for (int lane = 0; lane < 4; lane++) {
+            out[count] = static_cast<uint16_t>(base + i + lane);
+            count += (lanes >> lane) & 1;
+        }
+    }
+    return filter_placements_tail<Span>(masks, pieces, n, i, window, available, base, out, count);
+}
+
+// Eight candidates per 512-bit vector; legal indices are compressed in-register
+// and the live count advances by the popcount of the lane mask.
+template <int Span>
+PENTOMINO_TARGET_AVX512
+int filter_placements_avx512(const uint64_t* masks, const uint8_t* pieces, int n,
+                             const uint64_t* window, uint32_t available,
+                             int base, uint16_t* out) {
+    __m512i occupied[Span];
+    for (int k = 0; k < Span; k++) occupied[k] = _mm512_set1_epi64(static_cast<long long>(window[k]));
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i avail = _mm512_set1_epi64(available);
+    const __m512i lane_index = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+
+    int count = 0;
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i hit = _mm512_setzero_si512();
+        for (int k = 0; k < Span; k++) {
+            __m512i cand = _mm512_loadu_si512(masks + k * n + i);
+            hit = _mm512_or_si512(hit, _mm512_and_si512(cand, occupied[k]));
+        }
+        __m512i piece_index = _mm512_cvtepu8_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pieces + i)));
+        __mmask8 piece_free = _mm512_test_epi64_mask(_mm512_srlv_epi64(avail, piece_index), one);
+        __mmask8 legal = _mm512_mask_testn_epi64_mask(piece_free, hit, hit);
+
+        __m512i ids = _mm512_add_epi64(lane_index, _mm512_set1_epi64(base + i));
+        __m512i packed = _mm512_maskz_compress_epi64(legal, ids);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + count), _mm512_cvtepi64_epi16(packed));
+        count += __builtin_popcount(legal);
+    }
+    return filter_placements_tail<Span>(masks, pieces, n, i, window, available, base, out, count);
+}
+#endif
+
+template <int Span>
+using FilterKernel = int (*)(const uint64_t*, const uint8_t*, int, const uint64_t*, uint32_t, int, uint16_t*);
+
+// Kernel used by the engines. WebAssembly has no runtime CPU dispatch inside a
+// module, so the SIMD128 path is picked at compile time (-msimd128) and the
+// loader chooses between the SIMD and baseline modules. Native x86 builds pick
+// AVX-512, AVX2 or scalar from CPUID.
+template <int Span>
+FilterKernel<Span> select_filter_kernel(KernelIsa isa) {
+#if defined(__wasm_simd128__)
+    if (isa == KernelIsa::SIMD128) return &filter_placements_simd128<Span>;
+#elif defined(PENTOMINO_X86_KERNELS)
+    if (isa == KernelIsa::AVX512) return &filter_placements_avx512<Span>;
+    if (isa == KernelIsa::AVX2) return &filter_placements_avx2<Span>;
+#endif
+    (void)isa;
+    return &filter_placements_scalar<Span>;
+}
+
+#endif // PENTOMINO_PLACEMENT_KERNELS_H
@@ -0,0 +1,196 @@
+#ifndef PENTOMINO_REGION_KERNELS_H
+#define PENTOMINO_REGION_KERNELS_H
+
+#include <cstdint>
+#include "cpu_features.h"
+
+// Flood fill of the empty region around a seed cell on a Words-word bitboard
+// laid out in rows of `stride` bits. Kernels return the region's cell count;
+// a region whose size is not a multiple of 5 can never be tiled.
+template <int Words>
+struct RegionMasks {
+    int stride = 0;                 // bits per row, 1..63
+    uint64_t not_first_col[Words];  // cells that may receive a +1 shift
+    uint64_t not_last_col[Words];   // cells that may receive a -1 shift
+};
+
+template <int Words>
+inline int region_size_scalar(const uint64_t* occupied, int seed, const RegionMasks<Words>& masks) {
+    const int s = masks.stride;
+    uint64_t empty[Words];
+    uint64_t region[Words] = {};
+    for (int i = 0; i < Words; i++) empty[i] = ~occupied[i];
+    region[seed >> 6] = 1ULL << (seed & 63);
+
+    for (;;) {
+        uint64_t grown[Words];
+        uint64_t changed = 0;
+        for (int i = 0; i < Words; i++) {
+            uint64_t lower = i > 0 ? region[i - 1] : 0;
+            uint64_t upper = i + 1 < Words ? region[i + 1] : 0;
+            uint64_t left = (region[i] << 1) | (lower >> 63);
+            uint64_t right = (region[i] >> 1) | (upper << 63);
+            uint64_t up = (region[i] << s) | (lower >> (64 - s));
+            uint64_t down = (region[i] >> s) | (upper << (64 - s));
+            grown[i] = (region[i] | (left & masks.not_first_col[i]) |
+                        (right & masks.not_last_col[i]) | up | down) & empty[i];
+            changed |= grown[i] ^ region[i];
+        }
+        for (int i = 0; i < Words; i++) region[i] = grown[i];
+        if (!changed) break;
+    }
+
+    int size = 0;
+    for (int i = 0; i < Words; i++) size += __builtin_popcountll(region[i]);
+    return size;
+}
+
+#ifdef PENTOMINO_X86_KERNELS
+// 256-bit lanes, Words a multiple of 4. Cross-word carries move one 64-bit lane
+// up or down with a permute and pull the neighbouring register's edge lane in.
+PENTOMINO_TARGET_AVX2
+inline __m256i lanes_up_avx2(__m256i x, __m256i previous) {
+    __m256i rotated = _mm256_permute4x64_epi64(x, 0x93);        // x2 x1 x0 x3
+    __m256i carry = _mm256_permute4x64_epi64(previous, 0xFF);   // previous lane 3
+    return _mm256_blend_epi32(rotated, carry, 0x03);
+}
+
+PENTOMINO_TARGET_AVX2
+inline __m256i lanes_down_avx2(__m256i x, __m256i next) {
+    __m256i rotated = _mm256_permute4x64_epi64(x, 0x39);        // x0 x3 x2 x1
+    __m256i carry = _mm256_permute4x64_epi64(next, 0x00);       // next lane 0
+    return _mm256_blend_epi32(rotated, carry, 0xC0);
+}
+
+// Vector popcount (nibble lookup) summed over all lanes
+PENTOMINO_TARGET_AVX2
+inline int popcount_avx2(const __m256i* values, int count) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    __m256i total = _mm256_setzero_si256();
+    for (int r = 0; r < count; r++) {
+        __m256i lo = _mm256_and_si256(values[r], low_nibble);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi64(values[r], 4), low_nibble);
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    return static_cast<int>(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+}
+
+template <int Words>
+PENTOMINO_TARGET_AVX2
+int region_size_avx2(const uint64_t* occupied, int seed, const RegionMasks<Words>& masks) {
+    static_assert(Words % 4 == 0, "AVX2 region kernel needs whole 256-bit registers");
+    constexpr int R = Words / 4;
+    const __m128i shift_one = _mm_cvtsi32_si128(1);
+    const __m128i shift_63 = _mm_cvtsi32_si128(63);
+    const __m128i shift_row = _mm_cvtsi32_si128(masks.stride);
+    const __m128i shift_row_carry = _mm_cvtsi32_si128(64 - masks.stride);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi64x(-1);
+
+    __m256i empty[R], first[R], last[R], region[R];
+    for (int r = 0; r < R; r++) {
+        empty[r] = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(occupied + 4 * r)), ones);
+        first[r] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks.not_first_col + 4 * r));
+        last[r] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks.not_last_col + 4 * r));
+        region[r] = zero;
+    }
+    alignas(32) uint64_t seed_words[Words] = {};
+    seed_words[seed >> 6] = 1ULL << (seed & 63);
+    for (int r = 0; r < R; r++) region[r] = _mm256_load_si256(reinterpret_cast<const __m256i*>(seed_words + 4 * r));
+
+    for (;;) {
+        __m256i grown[R];
+        __m256i changed = zero;
+        for (int r = 0; r < R; r++) {
+            __m256i below = lanes_up_avx2(region[r], r > 0 ? region[r - 1] : zero);
+            __m256i above = lanes_down_avx2(region[r], r + 1 < R ? region[r + 1] : zero);
+            __m256i left = _mm256_or_si256(_mm256_sll_epi64(region[r], shift_one), _mm256_srl_epi64(below, shift_63));
+            __m256i right = _mm256_or_si256(_mm256_srl_epi64(region[r], shift_one), _mm256_sll_epi64(above, shift_63));
+            __m256i up = _mm256_or_si256(_mm256_sll_epi64(region[r], shift_row), _mm256_srl_epi64(below, shift_row_carry));
+            __m256i down = _mm256_or_si256(_mm256_srl_epi64(region[r], shift_row), _mm256_sll_epi64(above, shift_row_carry));
+            __m256i g = _mm256_or_si256(region[r], _mm256_or_si256(up, down));
+            g = _mm256_or_si256(g, _mm256_and_si256(left, first[r]));
+            g = _mm256_or_si256(g, _mm256_and_si256(right, last[r]));
+            grown[r] = _mm256_and_si256(g, empty[r]);
+            changed = _mm256_or_si256(changed, _mm256_xor_si256(grown[r], region[r]));
+        }
+        for (int r = 0; r < R; r++) region[r] = grown[r];
+        if (_mm256_testz_si256(changed, changed)) break;
+    }
+    return popcount_avx2(region, R);
+}
+
+// One 512-bit register holds an 8-word board; valignq shifts lanes with carry-in
+PENTOMINO_TARGET_AVX512
+inline __m512i flood_region_avx512(const uint64_t* occupied, int seed, const RegionMasks<8>& masks) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i empty = _mm512_xor_si512(_mm512_loadu_si512(occupied), _mm512_set1_epi64(-1));
+    const __m512i first = _mm512_loadu_si512(masks.not_first_col);
+    const __m512i last = _mm512_loadu_si512(masks.not_last_col);
+    const __m128i shift_one = _mm_cvtsi32_si128(1);
+    const __m128i shift_63 = _mm_cvtsi32_si128(63);
+    const __m128i shift_row = _mm_cvtsi32_si128(masks.stride);
+    const __m128i shift_row_carry = _mm_cvtsi32_si128(64 - masks.stride);
+
+    __m512i region = _mm512_maskz_set1_epi64(static_cast<__mmask8>(1u << (seed >> 6)),
+                                             static_cast<long long>(1ULL << (seed & 63)));
+    for (;;) {
+        __m512i below = _mm512_alignr_epi64(region, zero, 7);   // lane i <- lane i-1
+        __m512i above = _mm512_alignr_epi64(zero, region, 1);   // lane i <- lane i+1
+        __m512i left = _mm512_or_si512(_mm512_sll_epi64(region, shift_one), _mm512_srl_epi64(below, shift_63));
+        __m512i right = _mm512_or_si512(_mm512_srl_epi64(region, shift_one), _mm512_sll_epi64(above, shift_63));
+        __m512i up = _mm512_or_si512(_mm512_sll_epi64(region, shift_row), _mm512_srl_epi64(below, shift_row_carry));
+        __m512i down = _mm512_or_si512(_mm512_srl_epi64(region, shift_row), _mm512_sll_epi64(above, shift_row_carry));
+        // region | up | down | (left & first) | (right & last), then & empty
+        __m512i g = _mm512_ternarylogic_epi64(region, up, down, 0xFE);
+        g = _mm512_ternarylogic_epi64(g, left, first, 0xF8);
+        g = _mm512_ternarylogic_epi64(g, right, last, 0xF8);
+        g = _mm512_and_si512(g, empty);
+        __mmask8 changed = _mm512_cmpneq_epi64_mask(g, region);
+        region = g;
+        if (!changed) return region;
+    }
+}
+
+PENTOMINO_TARGET_AVX512
+inline int region_size_avx512(const uint64_t* occupied, int seed, const RegionMasks<8>& masks) {
+    alignas(64) uint64_t words[8];
+    _mm512_store_si512(words, flood_region_avx512(occupied, seed, masks));
+    int size = 0;
+    for (int i = 0; i < 8; i++) size += __builtin_popcountll(words[i]);
+    return size;
+}
+
+// Same fill, counted with VPOPCNTQ when the host has AVX-512 VPOPCNTDQ
+PENTOMINO_TARGET_AVX512_POPCNT
+inline int region_size_avx512_vpopcnt(const uint64_t* occupied, int seed, const RegionMasks<8>& masks) {
+    __m512i region = flood_region_avx512(occupied, seed, masks);
+    return static_cast<int>(_mm512_reduce_add_epi64(_mm512_popcnt_epi64(region)));
+}
+#endif
+
+template <int Words>
+using RegionKernel = int (*)(const uint64_t*, int, const RegionMasks<Words>&);
+
+// Words 1-3 stay scalar: one word is already a single register per operation
+template <int Words>
+RegionKernel<Words> select_region_kernel(KernelIsa isa) {
+#ifdef PENTOMINO_X86_KERNELS
+    if constexpr (Words == 8) {
+        if (isa == KernelIsa::AVX512) {
+            return host_has_vector_popcount() ? &region_size_avx512_vpopcnt : &region_size_avx512;
+        }
+    }
+    if constexpr (Words % 4 == 0) {
+        if (isa == KernelIsa::AVX2 || isa == KernelIsa::AVX512) return &region_size_avx2<Words>;
+    }
+#endif
+    (void)isa;
+    return &region_size_scalar<Words>;
+}
+
+#endif // PENTOMINO_REGION_KERNELS_H
@@ -0,0 +1,177 @@
+#ifndef PENTOMINO_ROWSET_ENGINE_H
+#define PENTOMINO_ROWSET_ENGINE_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "solver_common.h"
+#include "arena.h"
+#include "pieces.h"
+#include "rowset_kernels.h"
+
+// Bit-parallel Algorithm X. Every placement on a 60-cell board is one of a few
+// thousand rows, so the rows still compatible with the partial solution fit in
+// one bitset and each column is a bitset over rows. Placing a row is an ANDNOT
+// of its six columns from the active set; choosing the column with the fewest
+// remaining rows is one AND + popcount per uncovered column. Both run in the
+// SIMD kernels of rowset_kernels.h.
+//
+// The search state of a depth is its frame: the active rows, the rows of the
+// chosen column left to try and the uncovered columns. Frames live in an array
+// on the stack, so descending writes the next frame and backtracking just
+// steps back to the previous one; nothing is undone.
+//
+// Makes the same choices as DlxEngine (columns in the same order, rows tried
+// in row order), so node counts match. Each piece is used at most once and at
+// most 128 columns and 4096 rows fit.
+class RowsetEngine {
+public:
+    static constexpr int ROW_COLUMNS = PIECE_CELLS + 1;
+    static constexpr int MAX_COLUMNS = 128;
+    static constexpr int MAX_ROWS = ROWSET_MAX_WORDS * 64;
+
+    static bool supports(const std::array<int, PIECE_TYPES>& counts) {
+        for (int c : counts) {
+            if (c > 1) return false;
+        }
+        return true;
+    }
+
+    // Build the column bitsets, allocated from the arena, which must outlive
+    // the engine. False when the board is too large for the row sets.
+    bool setup(int width, int height, const uint8_t* open,
+               const OrientationTable& orientations,
+               const std::array<int, PIECE_TYPES>& counts, Arena& arena) {
+        if (!supports(counts)) return false;
+
+        // Columns: the pieces in use, then the open cells
+        int piece_column[PIECE_TYPES];
+        int columns = 0;
+        for (int p = 0; p < PIECE_TYPES; p++) {
+            piece_column[p] = counts[p] > 0 ? columns++ : -1;
+        }
+        pieces_ = columns;
+        int* cell_column = arena.allocate<int>(width * height);
+        for (int i = 0; i < width * height; i++) {
+            cell_column[i] = open[i] ? columns++ : -1;
+        }
+        if (columns > MAX_COLUMNS) return false;
+
+        int rows = 0;
+        for_each_board_placement(width, height, open, orientations, counts, [&](int, const int*) { rows++; });
+        if (rows > MAX_ROWS) return false;
+
+        words_ = (rows + 63) / 64;
+        words_ = (words_ + ROWSET_WORD_ALIGN - 1) / ROWSET_WORD_ALIGN * ROWSET_WORD_ALIGN;
+        if (words_ == 0) words_ = ROWSET_WORD_ALIGN;
+        columns_ = arena.allocate_filled<uint64_t>(static_cast<size_t>(columns) * words_, 0);
+        row_columns_ = arena.allocate<int>(static_cast<size_t>(rows) * ROW_COLUMNS);
+        placements_ = arena.allocate<PlacedPiece>(rows);
+        all_rows_ = arena.allocate_filled<uint64_t>(words_, 0);
+
+        uncovered_[0] = uncovered_[1] = 0;
+        for (int c = 0; c < columns; c++) uncovered_[c >> 6] |= 1ULL << (c & 63);
+
+        int row = 0;
+        for_each_board_placement(width, height, open, orientations, counts, [&](int piece, const int* cells) {
+            int* row_columns = row_columns_ + static_cast<size_t>(row) * ROW_COLUMNS;
+            placements_[row].piece = piece;
+            row_columns[0] = piece_column[piece];
+            for (int i = 0; i < PIECE_CELLS; i++) {
+                placements_[row].cells[i] = cells[i];
+                row_columns[i + 1] = cell_column[cells[i]];
+            }
+            for (int k = 0; k < ROW_COLUMNS; k++) {
+                columns_[static_cast<size_t>(row_columns[k]) * words_ + (row >> 6)] |= 1ULL << (row & 63);
+            }
+            all_rows_[row >> 6] |= 1ULL << (row & 63);
+            row++;
+        });
+
+        KernelIsa isa = active_kernel_isa();
+        choose_ = select_rowset_choose_kernel(isa);
+        eliminate_ = select_rowset_eliminate_kernel(isa);
+        return true;
+    }
+
+    void solve(SearchControl& control, const SolutionCallback& on_solution) {
+        if (pieces_ == 0) return;
+
+        Frame frames[PIECE_TYPES + 1];
+        PlacedPiece solution[PIECE_TYPES];
+        Frame* frame = frames;
+        std::memcpy(frame->active, all_rows_, sizeof(uint64_t) * words_);
+        frame->uncovered[0] = uncovered_[0];
+        frame->uncovered[1] = uncovered_[1];
+        if (!open_frame(*frame)) return;
+
+        while (frame >= frames) {
+            // Next untried row of the chosen column
+            while (frame->word < words_ && frame->pending[frame->word] == 0) frame->word++;
+            if (frame->word == words_) {
+                frame--;
+                continue;
+            }
+            uint64_t& bits = frame->pending[frame->word];
+            int row = frame->word * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            frame->row = row;
+
+            control.nodes++;
+            if (control.should_stop()) break;
+
+            const int* row_columns = row_columns_ + static_cast<size_t>(row) * ROW_COLUMNS;
+            Frame* next = frame + 1;
+            next->uncovered[0] = frame->uncovered[0];
+            next->uncovered[1] = frame->uncovered[1];
+            for (int k = 0; k < ROW_COLUMNS; k++) {
+                next->uncovered[row_columns[k] >> 6] &= ~(1ULL << (row_columns[k] & 63));
+            }
+
+            if ((next->uncovered[0] | next->uncovered[1]) == 0) {
+                int depth = static_cast<int>(next - frames);
+                if (!control.reserve_solution()) break;
+                for (int d = 0; d < depth; d++) solution[d] = placements_[frames[d].row];
+                control.solutions++;
+                if (on_solution) on_solution(solution, depth);
+                if (control.solution_limit_reached()) break;
+                continue;
+            }
+
+            eliminate_(next->active, frame->active, columns_, row_columns, words_);
+            if (open_frame(*next)) frame = next;
+        }
+    }
+
+private:
+    struct Frame {
+        alignas(64) uint64_t active[ROWSET_MAX_WORDS];   // rows compatible with the placements above
+        alignas(64) uint64_t pending[ROWSET_MAX_WORDS];  // rows of the chosen column not tried yet
+        uint64_t uncovered[2];
+        int word;   // first pending word that may be non-zero
+        int row;    // row placed at this depth
+    };
+
+    int pieces_ = 0;
+    int words_ = 0;
+    uint64_t uncovered_[2] = {0, 0};
+    uint64_t* columns_ = nullptr;      // words_ per column
+    uint64_t* all_rows_ = nullptr;
+    int* row_columns_ = nullptr;       // ROW_COLUMNS per row
+    PlacedPiece* placements_ = nullptr;
+    RowsetChooseKernel choose_ = nullptr;
+    RowsetEliminateKernel eliminate_ = nullptr;
+
+    // Choose the column for a new depth; false when some column has no rows left
+    bool open_frame(Frame& frame) const {
+        int count = 0;
+        int column = choose_(frame.active, columns_, frame.uncovered, words_, count);
+        if (count == 0) return false;
+        const uint64_t* rows = columns_ + static_cast<size_t>(column) * words_;
+        for (int i = 0; i < words_; i++) frame.pending[i] = frame.active[i] & rows[i];
+        frame.word = 0;
+        return true;
+    }
+};
+
+#endif // PENTOMINO_ROWSET_ENGINE_H
@@ -0,0 +1,215 @@
+#ifndef PENTOMINO_ROWSET_KERNELS_H
+#define PENTOMINO_ROWSET_KERNELS_H
+
+#include <cstdint>
+#include "cpu_features.h"
+#include "region_kernels.h"
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+// Kernels for bit-parallel Algorithm X. Rows of the exact cover matrix are bits
+// of a row set; each column is the set of rows containing it, stored as `words`
+// consecutive words at columns + c * words. `words` is a multiple of
+// ROWSET_WORD_ALIGN so the vector kernels have no tails.
+constexpr int ROWSET_WORD_ALIGN = 8;
+constexpr int ROWSET_MAX_WORDS = 64;    // 4096 rows
+
+// Uncovered column with the fewest active rows: scans the set bits of
+// uncovered[0..1] in order and stops early at a column with no rows left.
+// Writes the row count to count.
+using RowsetChooseKernel = int (*)(const uint64_t* active, const uint64_t* columns,
+                                   const uint64_t* uncovered, int words, int& count);
+
+// out = active & ~(columns[c0] | ... | columns[c5]): drops every row sharing a
+// column with the placed row, the row itself included
+using RowsetEliminateKernel = void (*)(uint64_t* out, const uint64_t* active, const uint64_t* columns,
+                                       const int* row_columns, int words);
+
+// Shared column scan; count(column) returns the active rows of one column
+template <typename Count>
+inline int rowset_choose(const uint64_t* columns, const uint64_t* uncovered, int words,
+                         int& count, Count&& count_rows) {
+    int best = -1;
+    int best_count = 0x7FFFFFFF;
+    for (int k = 0; k < 2 && best_count > 0; k++) {
+        uint64_t pending = uncovered[k];
+        while (pending && best_count > 0) {
+            int c = k * 64 + __builtin_ctzll(pending);
+            pending &= pending - 1;
+            int n = count_rows(columns + static_cast<size_t>(c) * words);
+            if (n < best_count) {
+                best = c;
+                best_count = n;
+            }
+        }
+    }
+    count = best_count;
+    return best;
+}
+
+inline int rowset_choose_scalar(const uint64_t* active, const uint64_t* columns,
+                                const uint64_t* uncovered, int words, int& count) {
+    return rowset_choose(columns, uncovered, words, count, [&](const uint64_t* column) {
+        int n = 0;
+        for (int i = 0; i < words; i++) n += __builtin_popcountll(active[i] & column[i]);
+        return n;
+    });
+}
+
+inline void rowset_eliminate_scalar(uint64_t* out, const uint64_t* active, const uint64_t* columns,
+                                    const int* row_columns, int words) {
+    const uint64_t* c0 = columns + static_cast<size_t>(row_columns[0]) * words;
+    const uint64_t* c1 = columns + static_cast<size_t>(row_columns[1]) * words;
+    const uint64_t* c2 = columns + static_cast<size_t>(row_columns[2]) * words;
+    const uint64_t* c3 = columns + static_cast<size_t>(row_columns[3]) * words;
+    const uint64_t* c4 = columns + static_cast<size_t>(row_columns[4]) * words;
+    const uint64_t* c5 = columns + static_cast<size_t>(row_columns[5]) * words;
+    for (int i = 0; i < words; i++) {
+        out[i] = active[i] & ~(c0[i] | c1[i] | c2[i] | c3[i] | c4[i] | c5[i]);
+    }
+}
+
+#ifdef __wasm_simd128__
+// Two words per v128; popcounts are per byte, widened into 32-bit lanes
+inline int rowset_choose_simd128(const uint64_t* active, const uint64_t* columns,
+                                 const uint64_t* uncovered, int words, int& count) {
+    return rowset_choose(columns, uncovered, words, count, [&](const uint64_t* column) {
+        v128_t total = wasm_i32x4_splat(0);
+        for (int i = 0; i < words; i += 2) {
+            v128_t both = wasm_v128_and(wasm_v128_load(active + i), wasm_v128_load(column + i));
+            v128_t bytes = wasm_i8x16_popcnt(both);
+            total = wasm_i32x4_add(total, wasm_u32x4_extadd_pairwise_u16x8(wasm_u16x8_extadd_pairwise_u8x16(bytes)));
+        }
+        return wasm_i32x4_extract_lane(total, 0) + wasm_i32x4_extract_lane(total, 1) +
+               wasm_i32x4_extract_lane(total, 2) + wasm_i32x4_extract_lane(total, 3);
+    });
+}
+
+inline void rowset_eliminate_simd128(uint64_t* out, const uint64_t* active, const uint64_t* columns,
+                                     const int* row_columns, int words) {
+    const uint64_t* c[6];
+    for (int k = 0; k < 6; k++) c[k] = columns + static_cast<size_t>(row_columns[k]) * words;
+    for (int i = 0; i < words; i += 2) {
+        v128_t hit = wasm_v128_or(wasm_v128_or(wasm_v128_load(c[0] + i), wasm_v128_load(c[1] + i)),
+                                  wasm_v128_or(wasm_v128_load(c[2] + i), wasm_v128_load(c[3] + i)));
+        hit = wasm_v128_or(hit, wasm_v128_or(wasm_v128_load(c[4] + i), wasm_v128_load(c[5] + i)));
+        wasm_v128_store(out + i, wasm_v128_andnot(wasm_v128_load(active + i), hit));
+    }
+}
+#endif
+
+#ifdef PENTOMINO_X86_KERNELS
+PENTOMINO_TARGET_AVX2
+inline int rowset_choose_avx2(const uint64_t* active, const uint64_t* columns,
+                              const uint64_t* uncovered, int words, int& count) {
+    int best = -1;
+    int best_count = 0x7FFFFFFF;
+    __m256i both[ROWSET_MAX_WORDS / 4];
+    for (int k = 0; k < 2 && best_count > 0; k++) {
+        uint64_t pending = uncovered[k];
+        while (pending && best_count > 0) {
+            int c = k * 64 + __builtin_ctzll(pending);
+            pending &= pending - 1;
+            const uint64_t* column = columns + static_cast<size_t>(c) * words;
+            for (int i = 0; i < words; i += 4) {
+                both[i / 4] = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(active + i)),
+                                               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i)));
+            }
+            int n = popcount_avx2(both, words / 4);
+            if (n < best_count) {
+                best = c;
+                best_count = n;
+            }
+        }
+    }
+    count = best_count;
+    return best;
+}
+
+PENTOMINO_TARGET_AVX2
+inline void rowset_eliminate_avx2(uint64_t* out, const uint64_t* active, const uint64_t* columns,
+                                  const int* row_columns, int words) {
+    const __m256i* c[6];
+    for (int k = 0; k < 6; k++) {
+        c[k] = reinterpret_cast<const __m256i*>(columns + static_cast<size_t>(row_columns[k]) * words);
+    }
+    for (int r = 0; r < words / 4; r++) {
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_loadu_si256(c[0] + r), _mm256_loadu_si256(c[1] + r)),
+                                      _mm256_or_si256(_mm256_loadu_si256(c[2] + r), _mm256_loadu_si256(c[3] + r)));
+        hit = _mm256_or_si256(hit, _mm256_or_si256(_mm256_loadu_si256(c[4] + r), _mm256_loadu_si256(c[5] + r)));
+        __m256i kept = _mm256_andnot_si256(hit, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(active) + r));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out) + r, kept);
+    }
+}
+
+// Eight words per register, counted with VPOPCNTQ
+PENTOMINO_TARGET_AVX512_POPCNT
+inline int rowset_choose_avx512(const uint64_t* active, const uint64_t* columns,
+                                const uint64_t* uncovered, int words, int& count) {
+    int best = -1;
+    int best_count = 0x7FFFFFFF;
+    for (int k = 0; k < 2 && best_count > 0; k++) {
+        uint64_t pending = uncovered[k];
+        while (pending && best_count > 0) {
+            int c = k * 64 + __builtin_ctzll(pending);
+            pending &= pending - 1;
+            const uint64_t* column = columns + static_cast<size_t>(c) * words;
+            __m512i total = _mm512_setzero_si512();
+            for (int i = 0; i < words; i += 8) {
+                __m512i both = _mm512_and_si512(_mm512_loadu_si512(active + i), _mm512_loadu_si512(column + i));
+                total = _mm512_add_epi64(total, _mm512_popcnt_epi64(both));
+            }
+            int n = static_cast<int>(_mm512_reduce_add_epi64(total));
+            if (n < best_count) {
+                best = c;
+                best_count = n;
+            }
+        }
+    }
+    count = best_count;
+    return best;
+}
+
+// OR of four columns with one ternary-logic op, then the last two and the ANDNOT
+PENTOMINO_TARGET_AVX512
+inline void rowset_eliminate_avx512(uint64_t* out, const uint64_t* active, const uint64_t* columns,
+                                    const int* row_columns, int words) {
+    const uint64_t* c[6];
+    for (int k = 0; k < 6; k++) c[k] = columns + static_cast<size_t>(row_columns[k]) * words;
+    for (int i = 0; i < words; i += 8) {
+        __m512i hit = _mm512_ternarylogic_epi64(_mm512_loadu_si512(c[0] + i), _mm512_loadu_si512(c[1] + i),
+                                                _mm512_loadu_si512(c[2] + i), 0xFE);
+        hit = _mm512_ternarylogic_epi64(hit, _mm512_loadu_si512(c[3] + i), _mm512_loadu_si512(c[4] + i), 0xFE);
+        hit = _mm512_or_si512(hit, _mm512_loadu_si512(c[5] + i));
+        _mm512_storeu_si512(out + i, _mm512_andnot_si512(hit, _mm512_loadu_si512(active + i)));
+    }
+}
+#endif
+
+inline RowsetChooseKernel select_rowset_choose_kernel(KernelIsa isa) {
+#ifdef __wasm_simd128__
+    if (isa == KernelIsa::SIMD128) return &rowset_choose_simd128;
+#endif
+#ifdef PENTOMINO_X86_KERNELS
+    if (isa == KernelIsa::AVX512 && host_has_vector_popcount()) return &rowset_choose_avx512;
+    if (isa == KernelIsa::AVX2 || isa == KernelIsa::AVX512) return &rowset_choose_avx2;
+#endif
+    (void)isa;
+    return &rowset_choose_scalar;
+}
+
+inline RowsetEliminateKernel select_rowset_eliminate_kernel(KernelIsa isa) {
+#ifdef __wasm_simd128__
+    if (isa == KernelIsa::SIMD128) return &rowset_eliminate_simd128;
+#endif
+#ifdef PENTOMINO_X86_KERNELS
+    if (isa == KernelIsa::AVX512) return &rowset_eliminate_avx512;
+    if (isa == KernelIsa::AVX2) return &rowset_eliminate_avx2;
+#endif
+    (void)isa;
+    return &rowset_eliminate_scalar;
+}
+
+#endif // PENTOMINO_ROWSET_KERNELS_H
@@ -0,0 +1,398 @@
+#ifndef PENTOMINO_SOLVE_SERVICE_H
+#define PENTOMINO_SOLVE_SERVICE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "pentomino_solver.h"
+#include "daemon_protocol.h"
+
+// Request multiplexer behind pentomino_daemon. Solve requests from any number
+// of clients queue up for a fixed pool of worker threads. Each worker owns one
+// PentominoSolver for its whole life, so orientation tables are built once per
+// thread and the solver's arena stays warm: after the first few boards a
+// request allocates nothing inside the search.
+//
+// Identical requests share one search. A request's canonical key is its board
+// mask, resolved piece counts, algorithm and limits; while a search (a
+// "flight") for that key is queued or running, further requests attach to it
+// as subscribers instead of starting their own. Each subscriber gets the final
+// RESULT under its own id, and streaming subscribers get SOLUTION frames from
+// the point they joined on, indexed from the start of the shared search.
+//
+// Requests come in two classes. Interactive ones (the default) are always
+// picked first. Batch ones (FLAG_BATCH) run in slices of BATCH_SLICE_NODES
+// search nodes, on a solver of their own; at every slice boundary the worker
+// checks for waiting interactive work and, if there is any, parks the batch
+// search (the solver keeps the paused engine state) at the head of the batch
+// queue and takes the interactive request instead. An interactive request thus
+// waits at most one slice for a worker, and batch work soaks up whatever the
+// interactive load leaves. Only the bitboard engine (the backtracking
+// algorithm) pauses; a batch search on any other engine keeps its worker to
+// the end. An interactive request joining a batch flight promotes it.
+//
+// Requests are keyed by (client, request id). cancel() detaches one
+// subscriber and answers it CANCELLED; a flight nobody is waiting for any
+// more is dropped from the queue or stopped through the solver's cancel flag.
+// Replies go to the sink given with the request, called from worker threads
+// and never with the queue lock held, since a sink may block (the daemon's
+// waits while its connection's frame queue is full). No frame for a request
+// follows its RESULT.
+class SolveService {
+public:
+    using Sink = std::function<void(std::vector<uint8_t> payload)>;
+
+    // Largest board accepted; solution frames carry cells as u16
+    static constexpr int MAX_CELLS = 65535;
+
+    // Nodes per batch slice: 10-20 ms of bitboard search
+    static constexpr long long BATCH_SLICE_NODES = 1 << 18;
+
+    explicit SolveService(int threads) {
+        if (threads < 1) threads = 1;
+        for (int i = 0; i < threads; i++) workers_.emplace_back([this] { work(); });
+    }
+
+    ~SolveService() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            shutting_down_ = true;
+            for (auto& entry : flights_) entry.second->cancelled = true;
+        }
+        ready_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    SolveService(const SolveService&) = delete;
+    SolveService& operator=(const SolveService&) = delete;
+
+    void submit(uint32_t client, const SolveRequest& request, Sink sink) {
+        auto subscriber = std::make_shared<Subscriber>();
+        subscriber->key = key_of(client, request.id);
+        subscriber->id = request.id;
+        subscriber->stream = (request.flags & FLAG_STREAM) != 0;
+        const bool interactive = (request.flags & FLAG_BATCH) == 0;
+        subscriber->sink = std::move(sink);
+
+        const int cells = request.width * request.height;
+        if (request.width <= 0 || request.height <= 0 || cells > MAX_CELLS) {
+            subscriber->finish(error_reply(request.id, "Invalid board size"));
+            return;
+        }
+
+        std::string key = canonical_key(request);
+        bool duplicate = false;
+        bool queued = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            duplicate = requests_.count(subscriber->key) != 0;
+            if (!duplicate) {
+                std::shared_ptr<Flight>& flight = flights_[key];
+                if (flight) {
+                    coalesced_++;
+                    if (interactive && !flight->interactive) {
+                        flight->interactive = true;
+                        queued = !flight->running && unqueue(flight);
+                        if (queued) interactive_.push_back(flight);
+                    }
+                } else {
+                    flight = std::make_shared<Flight>();
+                    flight->key = key;
+                    flight->request = request;
+                    flight->interactive = interactive;
+                    (interactive ? interactive_ : batch_).push_back(flight);
+                    queued = true;
+                }
+                flight->subscribers.push_back(subscriber);
+                flight->version++;
+                requests_[subscriber->key] = flight;
+            }
+        }
+        if (duplicate) {
+            subscriber->finish(error_reply(request.id, "Duplicate request id"));
+            return;
+        }
+        if (queued) ready_.notify_one();
+    }
+
+    void cancel(uint32_t client, uint32_t id) {
+        std::vector<std::shared_ptr<Subscriber>> detached;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            detach(key_of(client, id), detached);
+        }
+        for (auto& subscriber : detached) subscriber->finish(cancelled_reply(subscriber->id));
+    }
+
+    // Cancel everything a client still has pending, e.g. when it disconnects
+    void cancel_client(uint32_t client) {
+        std::vector<std::shared_ptr<Subscriber>> detached;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<uint64_t> keys;
+            for (const auto& entry : requests_) {
+                if (static_cast<uint32_t>(entry.first >> 32) == client) keys.push_back(entry.first);
+            }
+            for (uint64_t key : keys) detach(key, detached);
+        }
+        for (auto& subscriber : detached) subscriber->finish(cancelled_reply(subscriber->id));
+    }
+
+    int threads() const {
+        return static_cast<int>(workers_.size());
+    }
+
+    // Requests that attached to an existing flight instead of starting one
+    long long coalesced() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return coalesced_;
+    }
+
+private:
+    struct Subscriber {
+        uint64_t key = 0;
+        uint32_t id = 0;
+        bool stream = false;
+        Sink sink;
+        std::mutex send_mutex;
+        bool finished = false;           // guarded by send_mutex
+
+        void send(std::vector<uint8_t> payload) {
+            std::lock_guard<std::mutex> lock(send_mutex);
+            if (!finished) sink(std::move(payload));
+        }
+
+        // Send the RESULT; later frames for this request are dropped
+        void finish(std::vector<uint8_t> payload) {
+            std::lock_guard<std::mutex> lock(send_mutex);
+            if (finished) return;
+            finished = true;
+            sink(std::move(payload));
+        }
+    };
+
+    struct Flight {
+        std::string key;
+        SolveRequest request;                                   // as first submitted
+        std::vector<std::shared_ptr<Subscriber>> subscribers;   // guarded by mutex_
+        std::atomic<uint32_t> version{0};                       // bumped when subscribers change
+        std::atomic<bool> cancelled{false};
+        bool running = false;                                   // guarded by mutex_
+        bool interactive = true;                                // guarded by mutex_
+
+        // Owned by the worker running the flight, kept while it is parked
+        std::unique_ptr<PentominoSolver> own_solver;            // batch flights only
+        PentominoSolver* solver = nullptr;                      // set once started
+        std::vector<std::shared_ptr<Subscriber>> streaming;
+        uint32_t seen_version = ~0u;
+        uint32_t streamed = 0;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::shared_ptr<Flight>> interactive_;
+    std::deque<std::shared_ptr<Flight>> batch_;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;   // queued and running
+    std::unordered_map<uint64_t, std::shared_ptr<Flight>> requests_;     // by subscriber key
+    long long coalesced_ = 0;
+    bool shutting_down_ = false;
+    std::vector<std::thread> workers_;
+
+    static uint64_t key_of(uint32_t client, uint32_t id) {
+        return static_cast<uint64_t>(client) << 32 | id;
+    }
+
+    // The SOLVE encoding of everything that affects the result, with whole
+    // sets spelled out as counts; id and streaming are per subscriber
+    static std::string canonical_key(const SolveRequest& request) {
+        SolveRequest canonical = request;
+        canonical.id = 0;
+        canonical.flags = 0;
+        if (canonical.piece_counts.empty()) {
+            int open = 0;
+            for (uint8_t blocked : request.blocked) open += blocked ? 0 : 1;
+            const int set_cells = PIECE_TYPES * PIECE_CELLS;
+            if (open > 0 && open % set_cells == 0) canonical.piece_counts.assign(PIECE_TYPES, open / set_cells);
+        }
+        std::vector<uint8_t> bytes = encode_solve(canonical);
+        return std::string(bytes.begin(), bytes.end());
+    }
+
+    // Remove one subscriber and cancel its flight if nobody else waits on it.
+    // Called with mutex_ held; the caller sends the CANCELLED replies.
+    void detach(uint64_t key, std::vector<std::shared_ptr<Subscriber>>& detached) {
+        auto it = requests_.find(key);
+        if (it == requests_.end()) return;
+        std::shared_ptr<Flight> flight = it->second;
+        requests_.erase(it);
+
+        auto& subscribers = flight->subscribers;
+        for (auto s = subscribers.begin(); s != subscribers.end(); ++s) {
+            if ((*s)->key == key) {
+                detached.push_back(*s);
+                subscribers.erase(s);
+                break;
+            }
+        }
+        flight->version++;
+        if (!subscribers.empty()) return;
+
+        flight->cancelled = true;
+        flights_.erase(flight->key);
+        if (!flight->running) unqueue(flight);
+    }
+
+    // Take a flight that is not running off its queue; called with mutex_ held
+    bool unqueue(const std::shared_ptr<Flight>& flight) {
+        for (auto* queue : {&interactive_, &batch_}) {
+            for (auto q = queue->begin(); q != queue->end(); ++q) {
+                if (*q == flight) {
+                    queue->erase(q);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void work() {
+        PentominoSolver solver;
+        for (;;) {
+            std::shared_ptr<Flight> flight;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return shutting_down_ || !interactive_.empty() || !batch_.empty(); });
+                if (shutting_down_) return;
+                auto& queue = interactive_.empty() ? batch_ : interactive_;
+                flight = queue.front();
+                queue.pop_front();
+                flight->running = true;
+            }
+
+            if (!run(solver, flight)) continue;   // parked
+
+            // Close the flight before replying, so an identical request starts
+            // a fresh search and clients may reuse their ids at once
+            SolveReply reply = make_reply(*flight);
+            if (flight->solver == &solver) {
+                solver.set_cancel_flag(nullptr);
+                solver.set_solution_callback(nullptr);
+            }
+            std::vector<std::shared_ptr<Subscriber>> subscribers;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = flights_.find(flight->key);
+                if (it != flights_.end() && it->second == flight) flights_.erase(it);
+                subscribers.swap(flight->subscribers);
+                for (auto& subscriber : subscribers) requests_.erase(subscriber->key);
+            }
+            for (auto& subscriber : subscribers) {
+                reply.id = subscriber->id;
+                subscriber->finish(encode_reply(reply));
+            }
+        }
+    }
+
+    // Search for every subscriber, streaming to those that asked. Returns
+    // false when a batch search was parked for interactive work, true when
+    // the search is over.
+    bool run(PentominoSolver& worker_solver, const std::shared_ptr<Flight>& handle) {
+        Flight& flight = *handle;
+        bool interactive;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            interactive = flight.interactive;
+        }
+        if (!flight.solver) {
+            if (interactive) {
+                flight.solver = &worker_solver;
+            } else {
+                flight.own_solver.reset(new PentominoSolver());
+                flight.solver = flight.own_solver.get();
+            }
+            if (!start(*flight.solver, flight)) return true;
+        }
+
+        for (;;) {
+            if (flight.solver->step(interactive ? 0 : BATCH_SLICE_NODES)) return true;
+            std::lock_guard<std::mutex> lock(mutex_);
+            interactive = flight.interactive;
+            if (interactive || interactive_.empty()) continue;
+            if (flight.cancelled) return true;   // nobody left to park it for
+            flight.running = false;
+            batch_.push_front(handle);
+            return false;
+        }
+    }
+
+    bool start(PentominoSolver& solver, Flight& flight) {
+        const SolveRequest& request = flight.request;
+        std::vector<std::pair<int, int>> blocked;
+        for (int i = 0; i < request.width * request.height; i++) {
+            if (request.blocked[i]) blocked.emplace_back(i % request.width, i / request.width);
+        }
+        solver.init_board(request.width, request.height, blocked);
+        solver.set_piece_counts(request.piece_counts);
+        solver.set_algorithm(solver_algorithm_name(request.algorithm));
+        solver.set_config(request.max_solutions, request.max_time_ms);
+        solver.set_cancel_flag(&flight.cancelled);
+
+        // Streaming subscribers, re-read only after the list changed
+        solver.set_solution_callback([this, &flight](const PlacedPiece* pieces, int count) {
+            if (flight.version.load() != flight.seen_version) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                flight.seen_version = flight.version.load();
+                flight.streaming.clear();
+                for (auto& subscriber : flight.subscribers) {
+                    if (subscriber->stream) flight.streaming.push_back(subscriber);
+                }
+            }
+            for (auto& subscriber : flight.streaming) {
+                subscriber->send(encode_solution(subscriber->id, flight.streamed, pieces, count));
+            }
+            flight.streamed++;
+        });
+        return solver.start();
+    }
+
+    static SolveReply make_reply(Flight& flight) {
+        const SolveRequest& request = flight.request;
+        SolveResult result = flight.solver->result();
+        SolveReply reply;
+        reply.status = flight.cancelled ? ReplyStatus::CANCELLED
+                     : result.success ? ReplyStatus::OK : ReplyStatus::ERROR;
+        reply.solutions = result.solutions_found;
+        reply.nodes = result.steps_explored;
+        reply.ms = static_cast<int>(result.solving_time);
+        reply.timed_out = result.timeout;
+        reply.engine = result.engine;
+        reply.error = result.error;
+        const int* cells = flight.solver->get_cells();
+        reply.board.assign(cells, cells + request.width * request.height);
+        return reply;
+    }
+
+    static std::vector<uint8_t> error_reply(uint32_t id, const char* error) {
+        SolveReply reply;
+        reply.id = id;
+        reply.status = ReplyStatus::ERROR;
+        reply.error = error;
+        return encode_reply(reply);
+    }
+
+    static std::vector<uint8_t> cancelled_reply(uint32_t id) {
+        SolveReply reply;
+        reply.id = id;
+        reply.status = ReplyStatus::CANCELLED;
+        return encode_reply(reply);
+    }
+};
+
+#endif // PENTOMINO_SOLVE_SERVICE_H
@@ -0,0 +1,141 @@
+#ifndef PENTOMINO_SOLVER_COMMON_H
+#define PENTOMINO_SOLVER_COMMON_H
+
+#include <vector>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+
+// Number of distinct pentomino piece types
+constexpr int PIECE_TYPES = 12;
+// Cells covered by every pentomino
+constexpr int PIECE_CELLS = 5;
+
+// A piece orientation as a list of (x, y) cell offsets
+using Shape = std::vector<std::pair<int, int>>;
+using OrientationTable = std::vector<std::vector<Shape>>;
+
+// One piece of a solution: piece type and the linear (y * width + x) cells it covers
+struct PlacedPiece {
+    int piece;
+    int cells[PIECE_CELLS];
+};
+
+// Called with the pieces of each solution; the buffer is reused between calls
+using SolutionCallback = std::function<void(const PlacedPiece*, int)>;
+
+// Partial cover handed out as a subtree job: the pieces, and for each level
+// searched below the given prefix the candidate index taken there, which
+// orders jobs the way the search visits them
+using PrefixCallback = std::function<void(const PlacedPiece*, int count, const uint8_t* path, int levels)>;
+
+// Solution limit shared by searches running in parallel. Each search
+// reserves a solution before reporting it, so together they report at most
+// the limit; the one taking the last reservation raises stop, which the
+// others watch as their stop_flag and see at their next node.
+struct SharedLimit {
+    std::atomic<long long> remaining{0};
+    std::atomic<bool> stop{false};
+    // When the last reservation was taken, written by the search taking it;
+    // read it only after every search has finished
+    std::chrono::steady_clock::time_point exhausted_at;
+};
+
+// Limits and counters shared between the solver front-end and a search engine
+struct SearchControl {
+    int max_solutions = 1;      // 0 = unlimited
+    int max_time_ms = 30000;    // 0 = unlimited
+    long long max_nodes = 0;    // 0 = unlimited
+    bool deterministic = false; // no wall-clock checks at all: max_time_ms is ignored
+    const std::atomic<bool>* stop_flag = nullptr;  // may be set from another thread
+    SharedLimit* shared_limit = nullptr;           // on top of max_solutions
+    long long pause_at = 0;     // node count where resumable engines pause, 0 = never
+    std::chrono::steady_clock::time_point start_time;
+
+    long long nodes = 0;
+    int solutions = 0;
+    bool stopped = false;
+    bool timed_out = false;
+    bool node_limit_reached = false;
+    bool paused = false;        // a resumable engine stopped at pause_at and can go on
+
+    // Wall-clock checks are only done every TIME_CHECK_INTERVAL nodes
+    static constexpr long long TIME_CHECK_INTERVAL = 4096;
+
+    bool solution_limit_reached() const {
+        return max_solutions > 0 && solutions >= max_solutions;
+    }
+
+    // Called by engines for each solution before counting or reporting it.
+    // False when a shared limit is used up: the solution is dropped and the
+    // search stops.
+    bool reserve_solution() {
+        if (!shared_limit) return true;
+        long long left = shared_limit->remaining.fetch_sub(1, std::memory_order_relaxed);
+        if (left <= 0) {
+            stopped = true;
+            return false;
+        }
+        if (left == 1) {
+            shared_limit->exhausted_at = std::chrono::steady_clock::now();
+            shared_limit->stop.store(true, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // Returns true when the search has to stop; called by engines once per
+    // node, after counting it. The node past max_nodes is not searched and
+    // not counted, so a node limited search reports exactly max_nodes.
+    bool should_stop() {
+        if (stopped) return true;
+        if (stop_flag && stop_flag->load(std::memory_order_relaxed)) {
+            stopped = true;
+            return true;
+        }
+        if (max_nodes > 0 && nodes > max_nodes) {
+            nodes = max_nodes;
+            node_limit_reached = true;
+            stopped = true;
+            return true;
+        }
+        if (clock_limited() && (nodes % TIME_CHECK_INTERVAL) == 0) {
+            check_clock();
+        }
+        return stopped;
+    }
+
+    // Same checks without the node interval, for engines that advance in
+    // bursts; those overshoot max_nodes by up to a burst
+    bool poll() {
+        if (stopped) return true;
+        if (stop_flag && stop_flag->load(std::memory_order_relaxed)) {
+            stopped = true;
+            return true;
+        }
+        if (max_nodes > 0 && nodes >= max_nodes) {
+            node_limit_reached = true;
+            stopped = true;
+            return true;
+        }
+        if (clock_limited()) check_clock();
+        return stopped;
+    }
+
+private:
+    bool clock_limited() const {
+        return max_time_ms > 0 && !deterministic;
+    }
+
+    void check_clock() {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time).count();
+        if (elapsed > max_time_ms) {
+            timed_out = true;
+            stopped = true;
+        }
+    }
+};
+
+#endif // PENTOMINO_SOLVER_COMMON_H